@@ -0,0 +1,67 @@
+#ifndef ALPHABET_H
+#define ALPHABET_H
+
+#include <cstddef>
+using namespace std;
+
+/**
+ * @brief Polítiques d'alfabet per als tries
+ *
+ * Cada política defineix en temps de compilació:
+ * - size: nombre de símbols (mida de la taula de fills de cada node)
+ * - index(c): índex del byte c dins l'alfabet, o -1 si no hi pertany
+ * - symbol(i): byte corresponent a l'índex i
+ *
+ * Com que size és constexpr, els nodes poden fer servir arrays de mida
+ * exacta i la traducció byte -> índex es resol sense taules dinàmiques.
+ */
+
+/**
+ * @brief Lletres minúscules 'a'-'z' (p.ex. words_alpha.txt)
+ */
+struct LowercaseAlphabet {
+    static constexpr size_t size = 26;
+    static constexpr int index(unsigned char c) {
+        return (c >= 'a' && c <= 'z') ? c - 'a' : -1;
+    }
+    static constexpr char symbol(size_t i) { return static_cast<char>('a' + i); }
+};
+
+/**
+ * @brief Qualsevol byte (0-255), per a text arbitrari com UTF-8
+ */
+struct ByteAlphabet {
+    static constexpr size_t size = 256;
+    static constexpr int index(unsigned char c) { return c; }
+    static constexpr char symbol(size_t i) { return static_cast<char>(i); }
+};
+
+/**
+ * @brief Nucleòtids d'ADN: 'A', 'C', 'G', 'T'
+ */
+struct DnaAlphabet {
+    static constexpr size_t size = 4;
+    static constexpr int index(unsigned char c) {
+        switch (c) {
+            case 'A': return 0;
+            case 'C': return 1;
+            case 'G': return 2;
+            case 'T': return 3;
+            default:  return -1;
+        }
+    }
+    static constexpr char symbol(size_t i) { return "ACGT"[i]; }
+};
+
+/**
+ * @brief Alfabet binari: '0' i '1'
+ */
+struct BinaryAlphabet {
+    static constexpr size_t size = 2;
+    static constexpr int index(unsigned char c) {
+        return (c == '0' || c == '1') ? c - '0' : -1;
+    }
+    static constexpr char symbol(size_t i) { return static_cast<char>('0' + i); }
+};
+
+#endif // ALPHABET_H
@@ -0,0 +1,77 @@
+#ifndef ASYNC_TRIE_H
+#define ASYNC_TRIE_H
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+#include "trie.h"
+#include "threadPool.h"
+using namespace std;
+
+/**
+ * @brief Façana asíncrona de qualsevol Trie sobre un ThreadPool
+ *
+ * Cada operació s'encua al pool i retorna un future, de manera que qui la
+ * crida (p. ex. un bucle d'esdeveniments) no es bloqueja. Les consultes es
+ * poden executar alhora; insert() espera que acabin les que estan en marxa
+ * (shared_mutex), així que el trie decorat només ha de suportar lectures
+ * concurrents.
+ *
+ * Les enumeracions grans (get_words_with_prefix() i
+ * stream_words_with_prefix()) es parteixen pel byte que segueix el prefix:
+ * un tros per a la paraula igual al prefix i un per a cada prefix + c que
+ * starts_with() dóna per bo. Els trossos s'executen en paral·lel al pool i es
+ * lliuren en ordre de byte a mesura que estan a punt. Tot passa per la
+ * interfície Trie, sense conèixer l'estructura del backend.
+ *
+ * L'AsyncTrie ha de viure fins que s'hagin completat tots els seus futures.
+ */
+class AsyncTrie {
+public:
+    /**
+     * @brief Rep els trossos d'una enumeració, en ordre i d'un en un
+     */
+    using ChunkVisitor = function<void(vector<string>&& words)>;
+
+    explicit AsyncTrie(unique_ptr<Trie> inner, ThreadPool& pool = ThreadPool::shared());
+
+    future<void> insert(const string& word);
+    future<bool> search(const string& word) const;
+    future<bool> starts_with(const string& prefix) const;
+
+    /**
+     * @brief Totes les paraules amb el prefix, enumerades en paral·lel; l'ordre
+     * és el dels trossos (byte següent sense signe) i, dins de cada tros, el del
+     * trie decorat
+     */
+    future<vector<string>> get_words_with_prefix(const string& prefix) const;
+
+    /**
+     * @brief Com get_words_with_prefix(), però lliurant cada tros no buit a
+     * 'on_chunk' tan aviat com ell i els anteriors han acabat (des d'un fil del
+     * pool; les crides no se solapen)
+     * @return Future amb el total de paraules lliurades
+     */
+    future<size_t> stream_words_with_prefix(const string& prefix, ChunkVisitor on_chunk) const;
+
+    const Trie& trie() const { return *inner; }
+
+private:
+    struct Enumeration;
+
+    unique_ptr<Trie> inner;
+    ThreadPool& pool;
+    mutable shared_mutex lock;
+
+    /**
+     * @brief Planifica els trossos d'una enumeració al pool; acaba cridant
+     * finish (amb l'excepció, si n'hi ha hagut cap)
+     */
+    void enumerate(const string& prefix, ChunkVisitor on_chunk, function<void(size_t, exception_ptr)> finish) const;
+    void run_chunk(const shared_ptr<Enumeration>& state, size_t index, const string& chunk_prefix) const;
+};
+
+#endif // ASYNC_TRIE_H
@@ -0,0 +1,150 @@
+#ifndef BIT_RADIX_H
+#define BIT_RADIX_H
+
+#include "profile.h"
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Trie radix amb un nombre de bits per nivell fixat en compilació
+ *
+ * Cada byte de la clau es consumeix en 8/Bits dígits de Bits bits (del bit
+ * més significatiu al menys), de manera que cada node té 2^Bits fills:
+ * - Bits = 1: trie binari (com el PatriciaTrie, però sense compressió)
+ * - Bits = 2, 4: fanout 4 o 16 (nibble)
+ * - Bits = 8: un nivell per byte (com el NaiveTrie)
+ *
+ * Augmentar Bits redueix la profunditat (8/Bits nivells per caràcter) a canvi
+ * de taules de fills més grans i més buides. El benchmark (bin/bench -b 1248)
+ * permet escombrar aquest compromís sobre cada corpus.
+ *
+ * Instanciacions disponibles: Bits = 1, 2, 4 i 8.
+ *
+ * @tparam Bits Bits consumits per nivell
+ */
+template <unsigned Bits>
+class BitRadixTrie {
+    static_assert(Bits == 1 || Bits == 2 || Bits == 4 || Bits == 8,
+                  "BitRadixTrie: Bits ha de ser 1, 2, 4 o 8");
+
+public:
+    static constexpr size_t fanout = size_t(1) << Bits;
+    static constexpr unsigned digits_per_byte = 8 / Bits;
+
+private:
+    /**
+     * @brief Node del trie: 2^Bits fills i les posicions de la clau que hi acaba
+     */
+    struct BitNode {
+        array<unique_ptr<BitNode>, fanout> children;
+        vector<int> positions;
+    };
+
+    unique_ptr<BitNode> root;
+    size_t nodes;
+
+    /**
+     * @brief Retorna el dígit j-èsim (0 = més significatiu) d'un byte
+     */
+    static unsigned digit(unsigned char c, unsigned j) {
+        return (c >> (8 - Bits * (j + 1))) & (fanout - 1);
+    }
+
+    /**
+     * @brief Baixa pel camí d'una clau sense crear nodes
+     * @return Node on acaba el camí, o nullptr si no existeix
+     */
+    BitNode* find_node(const string& key) const;
+
+    /**
+     * @brief Funció auxiliar per recollir posicions d'un subarbre
+     */
+    void collect_positions(const BitNode* node, vector<int>& positions) const;
+
+    /**
+     * @brief Funció auxiliar per recollir paraules i posicions d'un subarbre
+     * @param node Node actual
+     * @param key Clau construïda fins al darrer byte complet
+     * @param partial Bits acumulats del byte en curs
+     * @param level Dígits ja consumits del byte en curs
+     * @param results Vector de parells (paraula, posició)
+     */
+    void collect_words(const BitNode* node, string& key, unsigned partial, unsigned level,
+                       vector<pair<string, int>>& results) const;
+
+    /**
+     * @brief Funció auxiliar de profile(): acumula un subarbre a l'informe
+     */
+    void profile_subtree(const BitNode* node, size_t depth, TrieProfile& report) const;
+
+public:
+    BitRadixTrie();
+
+    /**
+     * @brief Inicialitza el trie amb un text (insereix tots els sufixos del text)
+     * @param text Text a processar
+     */
+    void init(const string& text);
+
+    /**
+     * @brief Insereix una paraula i la seva posició
+     * @param word Paraula a inserir
+     * @param position Posició de la paraula al text original
+     */
+    void insert(const string& word, int position);
+
+    /**
+     * @brief Cerca una paraula i retorna les posicions on apareix
+     */
+    vector<int> search(const string& word) const;
+
+    /**
+     * @brief Troba les posicions de totes les paraules que comencen amb un prefix
+     */
+    vector<int> starts_with(const string& prefix) const;
+
+    /**
+     * @brief Retorna les paraules (amb posició) que comencen amb un prefix, en ordre
+     */
+    vector<pair<string, int>> autocomplete(const string& prefix) const;
+
+    /**
+     * @brief Obté totes les paraules del trie
+     */
+    vector<pair<string, int>> get_words() const;
+
+    /**
+     * @brief Neteja el trie
+     */
+    void clear();
+
+    /**
+     * @brief Comprova si el trie està buit
+     */
+    bool empty() const;
+
+    /**
+     * @brief Nombre de nodes (arrel inclosa)
+     */
+    size_t node_count() const { return nodes; }
+
+    /**
+     * @brief Memòria aproximada dels nodes (sense comptar les posicions)
+     */
+    size_t memory_bytes() const { return nodes * sizeof(BitNode); }
+
+    /**
+     * @brief Perfil de memòria i forma del trie (profunditat en dígits)
+     */
+    TrieProfile profile() const;
+};
+
+using BinaryRadixTrie = BitRadixTrie<1>;
+using NibbleRadixTrie = BitRadixTrie<4>;
+using ByteRadixTrie = BitRadixTrie<8>;
+
+#endif // BIT_RADIX_H
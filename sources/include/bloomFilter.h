@@ -0,0 +1,63 @@
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Filtre de Bloom per blocs (split block Bloom filter)
+ *
+ * El filtre és un vector de blocs de 64 bytes (una línia de cache). Cada
+ * element tria un bloc amb els 32 bits alts del seu hash i hi marca 8 bits,
+ * un a cada paraula de 64 bits del bloc, derivats dels 32 bits baixos. Així
+ * tant add() com may_contain() toquen una sola línia de cache, a canvi d'una
+ * taxa de falsos positius una mica més alta que la d'un Bloom clàssic.
+ *
+ * No hi ha falsos negatius: si may_contain() retorna false l'element segur
+ * que no s'ha afegit. No es poden treure elements (vegeu clear()).
+ */
+class BlockedBloomFilter {
+public:
+    /**
+     * @param expected_items Elements previstos (capacity())
+     * @param bits_per_item Bits del filtre per element; amb 12 els falsos
+     *        positius són per sota de l'1% quan el filtre és ple
+     */
+    explicit BlockedBloomFilter(size_t expected_items = 1024, size_t bits_per_item = 12);
+
+    /**
+     * @brief Afegeix un element a partir del seu hash de 64 bits
+     */
+    void add(uint64_t hash);
+
+    /**
+     * @brief Consulta un element
+     * @return false si l'element segur que no hi és; true si pot ser-hi
+     */
+    bool may_contain(uint64_t hash) const;
+
+    /**
+     * @brief Buida el filtre (manté la mida)
+     */
+    void clear();
+
+    size_t capacity() const { return max_items; }
+    size_t size() const { return items; }
+    size_t memory_bytes() const { return blocks.size() * sizeof(Block); }
+
+private:
+    struct alignas(64) Block {
+        uint64_t words[8];
+    };
+
+    vector<Block> blocks;
+    size_t max_items;
+    size_t items = 0;
+
+    size_t block_index(uint64_t hash) const {
+        return static_cast<size_t>(((hash >> 32) * blocks.size()) >> 32);
+    }
+};
+
+#endif // BLOOM_FILTER_H
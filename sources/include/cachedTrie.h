@@ -0,0 +1,117 @@
+#ifndef CACHED_TRIE_H
+#define CACHED_TRIE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "trie.h"
+using namespace std;
+
+/**
+ * @brief Decorador de qualsevol Trie amb una cache LRU de resultats per prefix
+ *
+ * Les consultes d'autocompletat es concentren en uns pocs prefixos curts, i
+ * cada crida torna a recórrer el mateix subarbre. CachedTrie guarda el
+ * resultat de search(), starts_with() i get_words_with_prefix(prefix, límit)
+ * en una cache de mida fitada, repartida en shards amb el seu propi mutex i
+ * la seva pròpia llista LRU perquè els fils no es bloquegin entre ells. La
+ * clau és (operació, prefix, límit), agrupada per prefix: una entrada guarda
+ * els resultats d'un mateix prefix (com a molt MaxLimitsPerEntry llistes de
+ * paraules) i surt de la cache sencera. Un límit més petit que un de guardat
+ * es respon a partir d'aquest.
+ *
+ * Una paraula nova només canvia els resultats dels seus prefixos, així que
+ * insert() esborra les entrades dels |paraula| + 1 prefixos de la paraula i
+ * res més. Si el trie decorat es modifica per fora (p. ex. RadixTrie::erase),
+ * cal cridar invalidate() amb la paraula.
+ *
+ * La cache és segura entre fils; el trie decorat ha de suportar les mateixes
+ * crides concurrents que se li facin (CachedTrie no el protegeix).
+ */
+class CachedTrie : public Trie {
+public:
+    /**
+     * @param inner Trie decorat
+     * @param capacity Prefixos guardats com a màxim (repartits entre els shards)
+     * @param shards Nombre de shards
+     */
+    explicit CachedTrie(unique_ptr<Trie> inner, size_t capacity = 4096, size_t shards = 16);
+
+    void insert(const string& word) override;
+    bool search(const string& word) const override;
+    bool starts_with(const string& prefix) const override;
+    vector<string> get_words_with_prefix(const string& prefix) const override;
+    vector<string> get_all_words() const override;
+    bool empty() const override;
+    void clear() override;
+
+    /**
+     * @brief Les 'limit' primeres paraules amb el prefix en ordre lexicogràfic
+     * (totes, en l'ordre del trie decorat, si limit és 0)
+     */
+    vector<string> get_words_with_prefix(const string& prefix, size_t limit) const;
+
+    /**
+     * @brief Esborra de la cache els resultats que canvien si 'word' s'afegeix
+     * o es treu del trie decorat (els de tots els seus prefixos)
+     */
+    void invalidate(const string& word);
+
+    uint64_t hits() const;
+    uint64_t misses() const;
+    size_t size() const;
+    const Trie& trie() const { return *inner; }
+
+private:
+    /**
+     * @brief Resultats guardats d'un prefix; -1 vol dir encara no consultat
+     */
+    struct Entry {
+        string prefix;
+        int8_t found = -1;       // search(prefix)
+        int8_t has_prefix = -1;  // starts_with(prefix)
+        vector<pair<size_t, shared_ptr<const vector<string>>>> words;  // per límit, el més antic primer
+    };
+
+    /**
+     * @brief Resultats de get_words_with_prefix() guardats com a molt per
+     * prefix (un de nou treu el més antic); els límits més petits que un de
+     * guardat se'n treuen sense guardar-los
+     */
+    static constexpr size_t MaxLimitsPerEntry = 4;
+
+    /**
+     * @brief Shard de la cache: la llista LRU (el més recent davant) i un
+     * índex hash per prefix que apunta a la llista. generation augmenta a cada
+     * invalidació, i un resultat calculat mentre n'hi ha hagut una no es guarda.
+     */
+    struct alignas(64) Shard {
+        mutable mutex lock;
+        list<Entry> lru;
+        unordered_map<string_view, list<Entry>::iterator> index;
+        uint64_t generation = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+    unique_ptr<Trie> inner;
+    size_t shard_capacity;
+    mutable vector<Shard> shards;
+
+    Shard& shard_of(string_view prefix) const {
+        return shards[hash<string_view>()(prefix) % shards.size()];
+    }
+
+    // Totes dues amb el mutex del shard agafat
+    Entry* find(Shard& shard, string_view prefix) const;
+    Entry& entry_for(Shard& shard, const string& prefix) const;
+
+    bool cached_flag(const string& prefix, int8_t Entry::*flag, bool (Trie::*query)(const string&) const) const;
+};
+
+#endif // CACHED_TRIE_H
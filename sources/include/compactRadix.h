@@ -0,0 +1,129 @@
+#ifndef COMPACT_RADIX_H
+#define COMPACT_RADIX_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "radixDone.h"
+#include "profile.h"
+using namespace std;
+
+/**
+ * @brief Còpia de només lectura d'un RadixTrie en memòria contigua
+ *
+ * Els nodes es copien en un sol vector en l'ordre que indiqui el Layout; les
+ * etiquetes i les arestes de cada node es guarden en vectors paral·lels en el
+ * mateix ordre, de manera que un recorregut arrel-fulla toca poques pàgines
+ * en lloc de nodes escampats pel heap en ordre d'inserció.
+ *
+ * Les posicions sempre es guarden en preordre: les de tot un subarbre són un
+ * rang contigu, i starts_with() només copia aquest rang.
+ *
+ * Les etiquetes, com al RadixTrie, són referències: el text indexat i el pool
+ * d'etiquetes es copien una sola vegada i només les etiquetes inline es
+ * concatenen. Així la còpia d'un índex de sufixos ocupa O(n) i no la suma de
+ * les longituds dels sufixos.
+ *
+ * Per afegir claus cal inserir-les al RadixTrie original i tornar a compactar.
+ */
+class CompactRadixTrie {
+public:
+    /**
+     * @brief Ordre dels nodes dins del buffer
+     * - BreadthFirst: nivell a nivell; els nivells alts (els més visitats) queden junts
+     * - Preorder: cada subarbre és un rang contigu
+     * - VanEmdeBoas: es parteix l'arbre per la meitat de l'alçada recursivament;
+     *   combina les dues propietats sense dependre de la mida de la línia de cache
+     */
+    enum class Layout { BreadthFirst, Preorder, VanEmdeBoas };
+
+    CompactRadixTrie();
+
+    /**
+     * @brief Copia un RadixTrie construït
+     * @param trie Trie d'origen (no es modifica)
+     * @param layout Ordre dels nodes dins del buffer
+     */
+    explicit CompactRadixTrie(const RadixTrie& trie, Layout layout = Layout::VanEmdeBoas);
+
+    vector<int> search(const string& word) const;
+    vector<int> starts_with(const string& prefix) const;
+    vector<pair<string, int>> autocomplete(const string& prefix) const;
+    vector<pair<string, int>> get_words() const;
+
+    bool empty() const;
+    size_t node_count() const { return nodes.size(); }
+    Layout layout() const { return node_layout; }
+
+    /**
+     * @brief Perfil de memòria i forma (mateix format que els altres backends)
+     */
+    TrieProfile profile() const;
+
+    /**
+     * @brief Nom llegible d'un layout
+     */
+    static const char* layout_name(Layout layout);
+
+private:
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    enum LabelSource : uint8_t { TextLabel, PoolLabel, InlineLabel };
+
+    /**
+     * @brief Node compactat (28 bytes): tot són índexs als vectors compartits
+     */
+    struct CompactNode {
+        uint32_t label_offset;      // a 'text', 'pool' o 'inline_labels' segons label_source
+        uint32_t label_length;
+        uint32_t first_edge;        // a 'edge_chars' / 'edge_targets'
+        uint32_t first_position;    // a 'positions': primera posició del node
+        uint32_t own_positions_end; // final de les posicions del node
+        uint32_t subtree_end;       // final de les posicions de tot el subarbre
+        uint16_t edge_count;
+        bool is_end_of_key;
+        uint8_t label_source;
+    };
+
+    vector<CompactNode> nodes;      // nodes[0] és l'arrel
+    string text;                    // còpia del text indexat del RadixTrie
+    string pool;                    // còpia del seu pool d'etiquetes
+    string inline_labels;           // etiquetes inline concatenades en ordre de layout
+    string edge_chars;              // primer caràcter de cada fill, ordenats per node
+    vector<uint32_t> edge_targets;  // índex del fill corresponent a cada edge_chars[i]
+    vector<int> positions;          // posicions en preordre
+    Layout node_layout;
+
+    /**
+     * @brief Índex del fill de 'node' que comença per c, o npos
+     */
+    uint32_t find_child(uint32_t node, char c) const;
+
+    const char* label_data(const CompactNode& compact) const {
+        const string& buffer = compact.label_source == TextLabel ? text
+                             : compact.label_source == PoolLabel ? pool : inline_labels;
+        return buffer.data() + compact.label_offset;
+    }
+
+    /**
+     * @brief Equivalent de RadixTrie::find_node sobre el buffer
+     * @return Índex del node on acaba la clau, o npos
+     */
+    uint32_t find_node(const string& key, size_t& depth) const;
+
+    void collect_words(uint32_t node, string& prefix, vector<pair<string, int>>& results) const;
+
+    // Construcció a partir del RadixTrie (classe amiga):
+    using SourceNode = RadixTrie::RadixNode;
+    static vector<const SourceNode*> children_of(const SourceNode* node);
+    static size_t height(const SourceNode* node);
+    static void layout_breadth_first(const SourceNode* root, vector<const SourceNode*>& order);
+    static void layout_preorder(const SourceNode* node, vector<const SourceNode*>& order);
+    static void layout_van_emde_boas(const SourceNode* node, size_t levels, vector<const SourceNode*>& order);
+    static void collect_frontier(const SourceNode* node, size_t depth, vector<const SourceNode*>& frontier);
+    void copy_positions(const SourceNode* node, const unordered_map<const SourceNode*, uint32_t>& index);
+};
+
+#endif // COMPACT_RADIX_H
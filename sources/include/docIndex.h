@@ -0,0 +1,183 @@
+#ifndef DOC_INDEX_H
+#define DOC_INDEX_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "radixDone.h"
+using namespace std;
+
+/**
+ * @brief Índex invertit de diversos documents sobre un RadixTrie
+ *
+ * Cada terme diferent s'insereix un sol cop al RadixTrie amb el seu
+ * identificador com a posició, de manera que search/starts_with del trie
+ * retornen identificadors de terme. El trie manté l'índex hash de paraules,
+ * així que cada ocurrència troba el seu terme amb una sola consulta. Les
+ * ocurrències de cada terme es guarden agrupades per document:
+ * - docs: documents on apareix el terme, en ordre creixent;
+ * - doc_begin: on comencen les ocurrències de cada document dins de 'words';
+ * - words: ordinal de la paraula dins del document (4 bytes per ocurrència).
+ * La línia i el paràgraf no es guarden per ocurrència: es recuperen amb una
+ * cerca binària a les taules de començament de línia/paràgraf del document.
+ *
+ * Els termes són seqüències de lletres i dígits (bytes >= 0x80 inclosos, per
+ * no trencar l'UTF-8, llevat de la puntuació U+2000-U+206F) passades a minúscules,
+ * tal com les parteix el Tokenizer.
+ *
+ * Les consultes de frase i de proximitat intersequen les llistes d'ordinals
+ * de cada document amb cerca exponencial (galloping): la llista més curta
+ * guia la intersecció i a les altres s'avança a salts, de manera que el cost
+ * depèn sobretot de la llista del terme més rar.
+ */
+class DocumentIndex {
+public:
+    static constexpr uint32_t all_documents = UINT32_MAX;
+
+    /**
+     * @brief Ocurrència d'un terme (línies, paràgrafs i paraules comencen a 0)
+     */
+    struct Posting {
+        uint32_t doc;        // identificador del document
+        uint32_t line;       // línia dins del document
+        uint32_t paragraph;  // paràgraf (blocs separats per línies en blanc)
+        uint32_t word;       // ordinal de la paraula dins del document
+    };
+
+    /**
+     * @brief Indexa un document
+     * @param name Nom del document (p. ex. el camí del fitxer)
+     * @param text Contingut
+     * @return Identificador del document
+     */
+    uint32_t add_document(const string& name, const string& text);
+
+    /**
+     * @brief Indexa un fitxer
+     * @return true si s'ha pogut llegir
+     */
+    bool add_file(const string& path);
+
+    /**
+     * @brief Indexa tots els fitxers regulars d'un directori (no recursiu), en ordre de nom
+     * @return Nombre de documents afegits
+     */
+    size_t add_directory(const string& path);
+
+    /**
+     * @brief Totes les ocurrències d'un terme, ordenades per (document, paraula)
+     */
+    vector<Posting> lookup(const string& term) const;
+
+    /**
+     * @brief Ocurrències d'un terme dins d'un sol document
+     *
+     * Només es llegeixen les ocurrències d'aquest document (cerca binària a 'docs').
+     */
+    vector<Posting> lookup(const string& term, uint32_t doc) const;
+
+    /**
+     * @brief Ocurrències d'una frase (termes consecutius)
+     * @param phrase Frase; es parteix en termes igual que els documents
+     * @param doc Document on cercar, o all_documents
+     * @return Posting de la primera paraula de cada ocurrència
+     */
+    vector<Posting> phrase_search(const string& phrase, uint32_t doc = all_documents) const;
+
+    /**
+     * @brief Ocurrències de 'a' amb alguna ocurrència de 'b' a com a molt k paraules
+     * @param doc Document on cercar, o all_documents
+     * @return Parells (ocurrència de a, ocurrència de b més propera)
+     */
+    vector<pair<Posting, Posting>> near(const string& a, const string& b, uint32_t k,
+                                        uint32_t doc = all_documents) const;
+
+    /**
+     * @brief Termes indexats que comencen per un prefix, en ordre alfabètic
+     */
+    vector<string> terms_with_prefix(const string& prefix) const;
+
+    /**
+     * @brief Normalitza un terme de consulta amb el Tokenizer, igual que els del text
+     * @return El terme, o buit si la consulta no en té exactament un (p. ex.
+     *         "don't" en són dos: per a això hi ha phrase_search())
+     */
+    static string normalize(const string& term);
+
+    /**
+     * @brief Identificador d'un document pel nom, o -1 si no existeix
+     */
+    int find_document(const string& name) const;
+
+    size_t document_count() const { return documents.size(); }
+    const string& document_name(uint32_t doc) const { return documents[doc].name; }
+    size_t document_words(uint32_t doc) const { return documents[doc].word_count; }
+    size_t term_count() const { return postings.size(); }
+    size_t posting_count() const { return total_postings; }
+
+    /**
+     * @brief Bytes aproximats de les llistes d'ocurrències i taules de línies/paràgrafs
+     */
+    size_t postings_bytes() const;
+
+    void clear();
+
+private:
+    /**
+     * @brief Ocurrències d'un terme agrupades per document
+     */
+    struct TermPostings {
+        vector<uint32_t> docs;
+        vector<uint32_t> doc_begin;
+        vector<uint32_t> words;
+
+        /**
+         * @brief Rang [begin, end) de 'words' del document i-èsim de 'docs'
+         */
+        uint32_t end_of(size_t i) const {
+            return i + 1 < docs.size() ? doc_begin[i + 1] : static_cast<uint32_t>(words.size());
+        }
+    };
+
+    struct Document {
+        string name;
+        uint32_t word_count = 0;
+        vector<uint32_t> line_starts;       // primera paraula de cada línia
+        vector<uint32_t> paragraph_starts;  // primera paraula de cada paràgraf
+    };
+
+    RadixTrie terms{true};          // terme -> identificador (a positions), amb índex hash
+    vector<TermPostings> postings;  // indexat per identificador de terme
+    vector<Document> documents;
+    size_t total_postings = 0;
+
+    /**
+     * @brief Identificador d'un terme ja normalitzat, o -1 si no està indexat
+     */
+    int term_id(const string& term) const;
+
+    /**
+     * @brief Construeix el Posting complet (línia i paràgraf) d'una ocurrència
+     */
+    Posting make_posting(uint32_t doc, uint32_t word) const;
+
+    /**
+     * @brief Documents on apareixen tots els termes (o només 'doc' si hi apareixen)
+     */
+    static vector<uint32_t> common_documents(const vector<const TermPostings*>& lists, uint32_t doc);
+
+    /**
+     * @brief Rang [begin, end) de 'words' d'un document, avançant des de 'cursor' a 'docs'
+     * @return false si el terme no apareix al document
+     */
+    static bool document_range(const TermPostings& list, uint32_t doc, size_t& cursor,
+                               uint32_t& begin, uint32_t& end);
+
+    /**
+     * @brief Afegeix una ocurrència d'un terme normalitzat
+     */
+    void add_occurrence(const string& term, uint32_t doc, uint32_t word);
+};
+
+#endif // DOC_INDEX_H
@@ -0,0 +1,77 @@
+#ifndef FILTERED_TRIE_H
+#define FILTERED_TRIE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "trie.h"
+#include "bloomFilter.h"
+using namespace std;
+
+/**
+ * @brief Decorador de qualsevol Trie amb un filtre de Bloom per a les fallades
+ *
+ * Al costat del trie es manté un BlockedBloomFilter amb dos tipus d'entrada:
+ * les paraules senceres i els seus prefixos de fins a prefix_length bytes.
+ * search() i starts_with() (i get_words_with_prefix()) consulten primer el
+ * filtre, i la majoria de cerques sense resultat es descarten amb un sol
+ * accés a memòria sense baixar pel trie. Els encerts i els falsos positius
+ * passen al trie, així que els resultats són exactament els mateixos.
+ *
+ * Un prefix més llarg que prefix_length es filtra pels seus primers
+ * prefix_length bytes. Quan s'insereixen més paraules que la capacitat del
+ * filtre, es reconstrueix amb el doble de capacitat a partir de
+ * get_all_words() (cost amortitzat constant per inserció).
+ */
+class FilteredTrie : public Trie {
+public:
+    /**
+     * @param inner Trie decorat (si ja té paraules s'afegeixen al filtre)
+     * @param prefix_length Longitud màxima dels prefixos del filtre (0: només paraules)
+     * @param expected_words Paraules previstes, per dimensionar el filtre
+     */
+    explicit FilteredTrie(unique_ptr<Trie> inner, size_t prefix_length = 8, size_t expected_words = 1024);
+
+    void insert(const string& word) override;
+    bool search(const string& word) const override;
+    bool starts_with(const string& prefix) const override;
+    vector<string> get_words_with_prefix(const string& prefix) const override;
+    vector<string> get_all_words() const override;
+    bool empty() const override;
+    void clear() override;
+
+    /**
+     * @brief Consultes descartades pel filtre sense arribar al trie
+     */
+    uint64_t rejected() const { return rejected_queries; }
+
+    /**
+     * @brief Consultes que han passat el filtre i han arribat al trie
+     */
+    uint64_t forwarded() const { return forwarded_queries; }
+
+    const BlockedBloomFilter& filter() const { return bloom; }
+    const Trie& trie() const { return *inner; }
+
+private:
+    unique_ptr<Trie> inner;
+    size_t max_prefix;
+    BlockedBloomFilter bloom;
+    mutable uint64_t rejected_queries = 0;
+    mutable uint64_t forwarded_queries = 0;
+
+    void add_word(const string& word);
+    void rebuild(size_t capacity);
+    bool may_have_prefix(const string& prefix) const;
+
+    /**
+     * @brief Hash de la paraula sencera o del prefix de 'length' bytes. Els
+     * dos tipus fan servir llavors diferents, i el hash polinòmic permet
+     * calcular tots els prefixos d'una paraula en una sola passada.
+     */
+    static uint64_t extend(uint64_t state, unsigned char c) { return (state + c + 1) * 0x100000001b3ULL; }
+    static uint64_t finish(uint64_t state, size_t length, uint64_t seed);
+};
+
+#endif // FILTERED_TRIE_H
@@ -0,0 +1,142 @@
+#ifndef INGEST_H
+#define INGEST_H
+
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "spscQueue.h"
+#include "tokenizer.h"
+using namespace std;
+
+/**
+ * @brief Comptadors d'una etapa del pipeline (sumats entre els seus fils)
+ */
+struct StageStats {
+    string name;
+    size_t threads = 0;
+    uint64_t items = 0;        // blocs llegits, blocs tokenitzats o lots inserits
+    uint64_t bytes = 0;        // bytes llegits / tokenitzats
+    uint64_t tokens = 0;       // termes emesos / inserits
+    double thread_ms = 0;      // temps de vida dels fils de l'etapa
+    double input_wait_ms = 0;  // esperant amb la cua d'entrada buida
+    double output_wait_ms = 0; // esperant amb la cua de sortida plena (backpressure)
+    uint64_t input_waits = 0;  // cops que la cua d'entrada era buida
+    uint64_t output_waits = 0; // cops que la cua de sortida era plena
+
+    /**
+     * @brief Fracció del temps dels fils que no s'ha passat esperant
+     */
+    double busy_ratio() const;
+
+    void merge(const StageStats& other);
+};
+
+/**
+ * @brief Resultat d'una execució del pipeline
+ */
+struct IngestStats {
+    double wall_ms = 0;
+    size_t files = 0;
+    size_t failed_files = 0;
+    uint64_t bytes = 0;
+    uint64_t tokens = 0;
+    size_t oversized_files = 0;  // fitxers no llegits: les posicions no hi cabrien en un int
+    vector<StageStats> stages;  // lector, tokenitzador, inseridor
+
+    /**
+     * @brief Informe llegible: throughput, ocupació i esperes de cada etapa
+     */
+    string to_string() const;
+};
+
+/**
+ * @brief Paràmetres del pipeline d'ingesta
+ */
+struct IngestOptions {
+    size_t lanes = 1;               // carrils lector + tokenitzador
+    size_t chunk_bytes = 1 << 16;   // mida dels blocs de lectura
+    size_t chunk_queue = 8;         // blocs en vol per carril
+    size_t batch_tokens = 512;      // termes per lot cap a un inseridor
+    size_t batch_queue = 64;        // lots en vol per (carril, inseridor)
+    Tokenizer::Isa isa = Tokenizer::best_isa();  // ISA del tokenitzador
+};
+
+/**
+ * @brief Ingesta de fitxers en un pipeline de fils: lector -> tokenitzador -> inseridors
+ *
+ * Els fitxers es reparteixen entre 'lanes' carrils. Cada carril té un fil
+ * lector, que llegeix blocs de chunk_bytes tallats a l'últim separador, i un
+ * fil tokenitzador, que parteix els blocs en termes amb el Tokenizer
+ * vectoritzat (lletres, dígits i bytes UTF-8, passats a minúscules). Els
+ * termes es reparteixen en lots entre els inseridors segons el primer byte
+ * (shard_of()), i cada inseridor és l'únic fil que escriu al seu trie. Totes les etapes es comuniquen amb SpscQueue
+ * acotades: una per carril entre lector i tokenitzador, i una per parell
+ * (carril, inseridor) entre tokenitzador i inseridor.
+ *
+ * La posició de cada terme és el seu desplaçament en bytes dins de la
+ * concatenació dels fitxers, en l'ordre en què es passen a run(). Les
+ * posicions dels tries són int: un fitxer que acabaria més enllà de MaxBytes
+ * no es llegeix (IngestStats::oversized_files) i no compta a la concatenació.
+ *
+ * Instanciacions disponibles: NaiveTrie, LowercaseNaiveTrie, PatriciaTrie,
+ * RadixTrie i BitRadixTrie<1, 2, 4, 8>.
+ *
+ * @tparam TrieType Backend amb insert(const string&, int)
+ */
+template <class TrieType>
+class IngestPipeline {
+public:
+    /**
+     * @param shards Un trie per inseridor (n'hi ha d'haver almenys un)
+     */
+    explicit IngestPipeline(const vector<TrieType*>& shards);
+    IngestPipeline(const vector<TrieType*>& shards, const IngestOptions& options);
+
+    /**
+     * @brief Bytes de la concatenació amb desplaçaments representables en un int
+     */
+    static constexpr uint64_t MaxBytes = uint64_t(INT_MAX) + 1;
+
+    /**
+     * @brief Llegeix, tokenitza i insereix tots els fitxers
+     * @return Comptadors per etapa i temps total
+     */
+    IngestStats run(const vector<string>& files);
+
+    /**
+     * @brief Shard (inseridor) on va a parar un terme; els termes amb el
+     * mateix primer byte comparteixen shard, i per tant també els prefixos
+     */
+    static size_t shard_of(const string& term, size_t shards) {
+        return term.empty() ? 0 : static_cast<unsigned char>(term[0]) % shards;
+    }
+
+private:
+    /**
+     * @brief Bloc de text llegit, amb el desplaçament global del primer byte
+     */
+    struct Chunk {
+        string data;
+        uint64_t offset = 0;
+    };
+
+    /**
+     * @brief Lot de termes cap a un inseridor; els termes són a 'text'
+     */
+    struct TokenBatch {
+        string text;
+        vector<uint32_t> ends;  // final de cada terme dins de 'text'
+        vector<int> positions;
+    };
+
+    vector<TrieType*> tries;
+    IngestOptions options;
+
+    void read_files(const vector<string>& files, const vector<uint64_t>& bases,
+                    SpscQueue<Chunk>& out, StageStats& stats, size_t& failed) const;
+    void tokenize(SpscQueue<Chunk>& in, vector<SpscQueue<TokenBatch>*>& out, StageStats& stats) const;
+    void insert_batches(TrieType& trie, vector<SpscQueue<TokenBatch>*>& in, StageStats& stats) const;
+};
+
+#endif // INGEST_H
@@ -0,0 +1,74 @@
+#ifndef INT_LPM_H
+#define INT_LPM_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Taula de prefix més llarg (LPM) per a claus enteres de 8 bytes
+ *
+ * Camí especialitzat de longest_prefix_match() per a claus de 64 bits (una
+ * adreça IP, un identificador o 8 bytes d'una cadena en big-endian): un trie
+ * multibit de 8 nivells amb un byte per nivell. Cada node és un array de 256
+ * cel·les, i un prefix de b bits s'expandeix a totes les cel·les del seu
+ * nivell que el comparteixen (expansió controlada de prefixos). Cada cel·la
+ * guarda el valor del prefix més llarg que la cobreix i, si n'hi ha, el
+ * node fill. Una consulta llegeix com a molt una cel·la per byte de la clau,
+ * sense comparacions de cadenes ni branques per bit.
+ *
+ * Els bits significatius d'un prefix són els alts: el prefix de 16 bits
+ * 0x0A0B000000000000 cobreix totes les claus que comencen pels bytes 0A 0B.
+ */
+class IntLpmTable {
+public:
+    IntLpmTable();
+
+    /**
+     * @brief Afegeix (o substitueix) un prefix
+     * @param prefix Clau amb els bits del prefix a dalt (els altres s'ignoren)
+     * @param length Bits del prefix, de 0 (ruta per defecte) a 64
+     * @param value Valor associat (p. ex. una posició o un identificador de ruta)
+     */
+    void insert(uint64_t prefix, unsigned length, int value);
+
+    /**
+     * @brief Valor del prefix més llarg que cobreix la clau
+     * @param key Clau de 64 bits
+     * @param value Sortida: valor del prefix (no es toca si no n'hi ha cap)
+     * @param length Sortida opcional: bits del prefix trobat
+     * @return true si algun prefix cobreix la clau
+     */
+    bool longest_prefix_match(uint64_t key, int& value, unsigned* length = nullptr) const;
+
+    /**
+     * @brief Converteix els 8 primers bytes d'una cadena en clau (big-endian,
+     * amb zeros si és més curta), de manera que els prefixos de bytes de la
+     * cadena són prefixos de bits de la clau
+     */
+    static uint64_t key_of(const string& bytes);
+
+    size_t node_count() const { return nodes.size(); }
+    size_t memory_bytes() const { return nodes.capacity() * sizeof(Node); }
+    void clear();
+
+private:
+    /**
+     * @brief Node de 256 cel·les; length 0 vol dir cel·la sense prefix i
+     * child 0 sense fill (l'arrel és el node 0 i mai no és fill de ningú)
+     */
+    struct Node {
+        int32_t value[256];
+        uint32_t child[256];
+        uint8_t length[256];
+
+        Node();
+    };
+
+    vector<Node> nodes;
+    bool has_default = false;
+    int default_value = 0;
+};
+
+#endif // INT_LPM_H
@@ -2,10 +2,13 @@
 #define NAIVE_H
 
 #include "trie.h"
+#include "alphabet.h"
+#include "stats.h"
+#include "profile.h"
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
-#include <unordered_map>
 using namespace std;
 
 /**
@@ -14,20 +17,65 @@ using namespace std;
  * Un Trie Naive és la implementació més bàsica d'una estructura de dades en forma 
  * d'arbre que permet emmagatzemar un conjunt dinàmic de strings. Ofereix operacions 
  * eficients d'inserció, cerca i eliminació de paraules.
+ * 
+ * La taula de fills de cada node té exactament Alphabet::size entrades (veure
+ * alphabet.h). Les paraules amb símbols fora de l'alfabet no s'insereixen ni
+ * es troben. Instanciacions disponibles: LowercaseAlphabet, ByteAlphabet,
+ * DnaAlphabet i BinaryAlphabet.
+ *
+ * Les enumeracions des de l'arrel o des d'un prefix d'un símbol (get_words(),
+ * get_all_words(), autocomplete(), starts_with_positions() i
+ * get_words_with_prefix()) es fan en paral·lel al ThreadPool compartit si el
+ * subarbre del prefix té almenys ParallelGrain nodes: cada subarbre a
+ * ForkLevels nivells del prefix és una tasca amb el seu propi vector, i els
+ * vectors es concatenen en l'ordre del recorregut seqüencial. Els nodes no
+ * saben la mida del seu subarbre, així que se'n compten fins a ParallelGrain
+ * abans de decidir; els prefixos més llargs solen tenir subarbres petits i es
+ * recorren en un sol fil sense comptar.
+ * 
+ * @tparam Alphabet Política d'alfabet (mida i traducció símbol -> índex)
  */
-class NaiveTrie : public Trie {
+template <class Alphabet>
+class BasicNaiveTrie : public Trie {
 private:
     /**
      * @brief Node intern del Trie
      */
     struct TrieNode {
-        vector<TrieNode*> children;
+        array<unique_ptr<TrieNode>, Alphabet::size> children;
         vector<int> index;
         bool end_of_word;
-        TrieNode() : children(128, nullptr), index(), end_of_word(false) {}
+        TrieNode() : children(), index(), end_of_word(false) {}
     };
     
     unique_ptr<TrieNode> root;
+    bool parallel_enumeration = true;
+
+#ifdef TRIE_STATS
+    mutable TrieStats counters;
+#endif
+
+    /**
+     * @brief Baixa pel camí d'una paraula sense crear nodes
+     * @param word Paraula o prefix a seguir
+     * @return Node on acaba el camí, o nullptr si no existeix
+     */
+    TrieNode* find_node(const string& word) const;
+
+    /**
+     * @brief Baixa pel camí d'una paraula creant els nodes que faltin
+     * @param word Paraula a inserir
+     * @return Node on acaba la paraula, o nullptr si té símbols fora de l'alfabet
+     */
+    TrieNode* create_path(const string& word);
+
+    /**
+     * @brief Funció auxiliar de profile(): acumula un subarbre a l'informe
+     * @param node Node actual
+     * @param depth Profunditat del node (0 = arrel)
+     * @param report Informe on s'acumula
+     */
+    void profile_subtree(const TrieNode* node, size_t depth, TrieProfile& report) const;
     
     /**
      * @brief Funció auxiliar per recollir totes les paraules amb un prefix
@@ -52,16 +100,62 @@ private:
      */
     void collect_positions_from_subtree(TrieNode* node, vector<int>& positions) const;
 
+    /**
+     * @brief Indica si té almenys 'budget' nodes el subarbre del node (el
+     * node inclòs); consumeix el pressupost
+     */
+    bool has_nodes(const TrieNode* node, size_t& budget) const;
+
+    /**
+     * @brief Indica si l'enumeració des del node del prefix es fa en paral·lel
+     */
+    bool enumerate_in_parallel(const TrieNode* node, const string& prefix) const;
+
+    /**
+     * @brief Recorregut paral·lel d'un subarbre
+     * @param node Node on acaba el prefix
+     * @param prefix Prefix del node
+     * @param results Vector on s'afegeixen els resultats, en ordre
+     * @param own Afegeix les entrades d'un sol node: own(node, clau, sortida)
+     * @param collect Recorregut seqüencial d'un subarbre: collect(node, clau, sortida)
+     */
+    template <class Result, class Own, class Collect>
+    void collect_parallel(TrieNode* node, const string& prefix, vector<Result>& results, const Own& own,
+                          const Collect& collect) const;
+
 public:
     /**
      * @brief Constructor del NaiveTrie
      */
-    NaiveTrie();
+    BasicNaiveTrie();
     
     /**
      * @brief Destructor del NaiveTrie
      */
-    ~NaiveTrie() = default;
+    ~BasicNaiveTrie() = default;
+
+    /**
+     * @brief Nivells per sota del prefix on cada subarbre passa a ser una tasca
+     */
+    static constexpr size_t ForkLevels = 2;
+
+    /**
+     * @brief Nodes que ha de tenir el subarbre del prefix perquè l'enumeració
+     * es reparteixi entre fils (per sota, les tasques costen més que la feina)
+     */
+    static constexpr size_t ParallelGrain = 8192;
+
+    /**
+     * @brief Activa o desactiva les enumeracions paral·leles (actives per
+     * defecte; amb STATS=1 sempre són seqüencials perquè els comptadors no
+     * són thread-safe)
+     */
+    void set_parallel_enumeration(bool enabled) { parallel_enumeration = enabled; }
+
+    /**
+     * @brief Indica si les enumeracions des del prefix es farien en paral·lel
+     */
+    bool enumerates_in_parallel(const string& prefix) const;
     
     /**
      * @brief Inicialitza el trie amb un text (insereix tots els sufixos del text)
@@ -102,6 +196,18 @@ public:
      * @return Vector de parells (paraula, posició)
      */
     vector<pair<string, int>> get_words() const;
+
+    /**
+     * @brief Clau més llarga que és prefix de l'entrada, en una sola baixada
+     * @param input Entrada (p. ex. una URL o un text per tokenitzar)
+     * @return Longitud i posicions de la clau; longitud 0 si no n'hi ha cap
+     */
+    PrefixMatch longest_prefix_match(const string& input) const;
+
+    /**
+     * @brief Totes les claus que són prefix de l'entrada, de més curta a més llarga
+     */
+    vector<PrefixMatch> all_prefix_matches(const string& input) const;
     
     // Métodos legacy para compatibilidad con Trie base
     void insert(const string& word) override;
@@ -121,6 +227,18 @@ public:
      */
     vector<string> get_all_words() const override;
     
+    /**
+     * @brief Retorna els comptadors d'instrumentació (buits sense TRIE_STATS)
+     * @return Còpia dels comptadors i histogrames de latència
+     */
+    TrieStats stats() const;
+
+    /**
+     * @brief Perfil de memòria i forma del trie
+     * @return Bytes per categoria, slots buits i histogrames de fanout/profunditat
+     */
+    TrieProfile profile() const;
+
     /**
      * @brief Comprova si el NaiveTrie està buit
      * @return true si no hi ha paraules emmagatzemades
@@ -133,4 +251,14 @@ public:
     void clear() override;
 };
 
+/**
+ * @brief NaiveTrie per defecte: accepta qualsevol byte (text UTF-8 inclòs)
+ */
+using NaiveTrie = BasicNaiveTrie<ByteAlphabet>;
+
+/**
+ * @brief NaiveTrie per a diccionaris en minúscules (words_alpha.txt)
+ */
+using LowercaseNaiveTrie = BasicNaiveTrie<LowercaseAlphabet>;
+
 #endif // NAIVE_H
\ No newline at end of file
@@ -1,29 +1,60 @@
 #ifndef PATRICIA_H
 #define PATRICIA_H
 
+#include "stats.h"
+#include "profile.h"
+#include "trie.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <utility>
 using namespace std;
 
 /**
- * @brief Nodo del Patricia Trie
+ * @brief Hoja del Patricia Trie
  * 
  * Almacena:
- * - number: Posición del bit donde se produce la ramificación
- * - data: La cadena almacenada en el nodo
- * - leftChild/rightChild: Hijos izquierdo y derecho
+ * - data: La cadena almacenada
  * - positions: Posiciones donde aparece la palabra en el texto
  */
-class PatriciaTrieNode {
+class PatriciaLeafNode {
 public:
-    int number;
     string data;
-    PatriciaTrieNode* leftChild;
-    PatriciaTrieNode* rightChild;
     vector<int> positions;
 
-    PatriciaTrieNode();
+    explicit PatriciaLeafNode(const string& key);
+};
+
+/**
+ * @brief Nodo interno (de ramificación) del Patricia Trie
+ * 
+ * Solo contiene el bit de ramificación, los dos hijos y la hoja más a la
+ * izquierda, así que cabe en 32 bytes (media línea de caché). Almacena:
+ * - byte/mask: Carácter y máscara del bit donde se produce la ramificación
+ *   (el índice es de 32 bits: las claves tienen como mucho MaxKeyLength bytes)
+ * - child[0]/child[1]: Hijos por bit 0 y bit 1, como punteros etiquetados:
+ *   el bit bajo a 1 indica que el hijo es una PatriciaLeafNode
+ * - leftmost: Hoja a la que se llega bajando siempre por el bit 0
+ */
+class PatriciaInternalNode {
+public:
+    uint32_t byte;
+    unsigned char mask;
+    uintptr_t child[2];
+    PatriciaLeafNode* leftmost;
+
+    PatriciaInternalNode(size_t byte, unsigned char mask);
+
+    /**
+     * @brief Indica si este nodo ramifica antes que el bit (byte, mask)
+     * @param b Índice de carácter del otro bit
+     * @param m Máscara del otro bit
+     * @return true si el bit del nodo precede al bit dado
+     */
+    bool before(size_t b, unsigned char m) const
+    {
+        return byte < b || (byte == b && mask > m);
+    }
 };
 
 /**
@@ -37,79 +68,154 @@ public:
  * Esta implementación trabaja con strings ASCII mediante extracción directa
  * de bits de los caracteres, sin necesidad de conversión a binario.
  * 
+ * Sigue el esquema crit-bit: los nodos internos solo guardan el bit de
+ * ramificación y los hijos, y las claves con sus posiciones viven en hojas
+ * separadas. No hay enlaces ascendentes, así que los recorridos no
+ * necesitan detectar ciclos.
+ * 
  * Características:
  * - Inserción eficiente: O(k) donde k es la longitud de la cadena
  * - Búsqueda eficiente: O(k) donde k es la longitud de la cadena
  * - Extracción de bits: O(1) por bit
- * - Capacidad máxima: 32 caracteres por cadena (256 bits)
+ * - Longitud de clave hasta MaxKeyLength: los bits fuera de la cadena valen 0,
+ *   por lo que dos claves solo son indistinguibles si difieren en bytes '\0'
+ *   finales
  */
 class PatriciaTrie {
 private:
-    PatriciaTrieNode* root;
-    static const int MaxBits = 256;  // 32 caracteres * 8 bits
+    uintptr_t root;  // 0 si el árbol está vacío
+
+#ifdef TRIE_STATS
+    mutable TrieStats counters;
+#endif
+
+    static bool is_leaf(uintptr_t p) { return (p & 1) != 0; }
+    static PatriciaLeafNode* as_leaf(uintptr_t p) { return reinterpret_cast<PatriciaLeafNode*>(p - 1); }
+    static PatriciaInternalNode* as_internal(uintptr_t p) { return reinterpret_cast<PatriciaInternalNode*>(p); }
+    static uintptr_t tag(PatriciaLeafNode* leaf) { return reinterpret_cast<uintptr_t>(leaf) + 1; }
+    static uintptr_t tag(PatriciaInternalNode* node) { return reinterpret_cast<uintptr_t>(node); }
 
     /**
-     * @brief Extrae el i-ésimo bit de una cadena
-     * 
-     * Cada carácter ASCII se representa con 8 bits. Los bits se numeran
-     * secuencialmente a través de todos los caracteres de la cadena.
-     * 
-     * Ejemplo para "AB":
-     * - 'A' (ASCII 65 = 01000001): bits 1-8
-     * - 'B' (ASCII 66 = 01000010): bits 9-16
-     * 
+     * @brief Hoja más a la izquierda de un subárbol, en O(1)
+     */
+    static PatriciaLeafNode* leftmost_leaf(uintptr_t p) { return is_leaf(p) ? as_leaf(p) : as_internal(p)->leftmost; }
+
+    /**
+     * @brief Extrae el bit de ramificación de un nodo interno
+     *
+     * Cada carácter ASCII se representa con 8 bits; el nodo guarda el índice
+     * del carácter y la máscara del bit, de modo que la prueba del camino de
+     * búsqueda no divide. Los bits fuera de la cadena valen 0.
+     *
      * @param str La cadena de la cual extraer el bit
-     * @param i Posición del bit (1-indexed)
-     * @return true si el bit es 1, false si es 0 o está fuera de rango
+     * @param node Nodo cuyo bit de ramificación se consulta
+     * @return 1 si el bit es 1, 0 si es 0 o está fuera de rango
      */
-    bool bit(const string& str, int i);
+    static int bit(const string& str, const PatriciaInternalNode* node)
+    {
+        return node->byte < str.length() &&
+               (static_cast<unsigned char>(str[node->byte]) & node->mask) != 0;
+    }
 
     /**
-     * @brief Función auxiliar de búsqueda recursiva
+     * @brief Calcula el primer bit en el que difieren dos cadenas
+     *
+     * Las cadenas se comparan como si estuvieran rellenadas con bits 0, de
+     * modo que una cadena y su extensión difieren en el primer bit no nulo
+     * del sufijo. La parte común se compara de 8 en 8 bytes: se cargan como
+     * enteros big-endian de 64 bits y el primer bit distinto sale de contar
+     * los ceros iniciales del XOR.
+     *
+     * @param a Primera cadena
+     * @param b Segunda cadena
+     * @return Posición (1-indexed) del primer bit distinto, o 0 si las
+     *         cadenas solo difieren en bytes '\0' finales
+     */
+    size_t critical_bit(const string& a, const string& b);
+
+    /**
+     * @brief Desciende siguiendo los bits de la cadena hasta una hoja
      * 
-     * Recorre el árbol siguiendo los bits de la cadena buscada hasta
-     * encontrar un nodo candidato.
+     * La hoja alcanzada es la única candidata a coincidir con la cadena.
      * 
-     * @param t Nodo actual
      * @param k Cadena a buscar
-     * @return Puntero al nodo encontrado o nullptr
+     * @return Hoja candidata o nullptr si el árbol está vacío
      */
-    PatriciaTrieNode* search(PatriciaTrieNode* t, const string& k);
+    PatriciaLeafNode* find_leaf(const string& k) const;
 
     /**
-     * @brief Función auxiliar de inserción recursiva
-     * 
-     * Inserta una nueva cadena en el árbol, creando nodos de ramificación
-     * solo donde las cadenas difieren.
+     * @brief Inserta una cadena creando un nodo interno donde difiere
      * 
-     * @param t Nodo actual
      * @param element Cadena a insertar
-     * @return Puntero a la raíz del subárbol
+     * @param inserted Se marca a true si la cadena no existía
+     * @return Hoja de la cadena (nueva o existente)
      */
-    PatriciaTrieNode* insert(PatriciaTrieNode* t, const string& element);
-    
+    PatriciaLeafNode* insert_leaf(const string& element, bool& inserted);
+
     /**
-     * @brief Función auxiliar de inserción con posición
-     * @param t Nodo actual
-     * @param element Cadena a insertar
-     * @param position Posición en el texto
-     * @return Puntero a la raíz del subárbol
+     * @brief Libera recursivamente un subárbol
+     * @param p Raíz etiquetada del subárbol
      */
-    PatriciaTrieNode* insert(PatriciaTrieNode* t, const string& element, int position);
-    
+    static void destroy(uintptr_t p);
+
+    /**
+     * @brief Función auxiliar de profile(): acumula un subárbol al informe
+     * @param p Raíz etiquetada del subárbol
+     * @param depth Profundidad del nodo (0 = raíz)
+     * @param report Informe donde se acumula
+     */
+    void profile_subtree(uintptr_t p, size_t depth, TrieProfile& report) const;
+
+    /**
+     * @brief Desciende por los bits de un prefijo hasta el subárbol que lo contiene
+     *
+     * Solo se consultan los nodos cuyo bit de ramificación cae dentro del
+     * prefijo, de modo que todas las claves del subárbol alcanzado coinciden
+     * entre sí en los bits del prefijo. Basta comparar una sola clave del
+     * subárbol para saber si todas empiezan por él.
+     *
+     * @param prefix Prefijo a buscar
+     * @return Raíz etiquetada del subárbol cuyas claves empiezan por el
+     *         prefijo, o 0 si ninguna clave empieza por él
+     */
+    uintptr_t find_prefix(const string& prefix) const;
+
+    /**
+     * @brief Desciende por los bits de una cadena y devuelve las hojas candidatas
+     * a ser prefijo suyo, de menor a mayor longitud
+     *
+     * Una clave K que es prefijo de la entrada coincide con ella en todos los
+     * bits de K, y a partir de |K| sus bits valen 0. Por eso K está en el
+     * subárbol del bit 0 de algún nodo donde la entrada va por el bit 1
+     * (siempre la hoja más a la izquierda de ese subárbol, y el nodo ramifica
+     * después de K), o es la hoja L a la que llega la entrada. En el primer
+     * caso K coincide con L en sus |K| bytes, así que basta comparar la
+     * entrada con L una sola vez: K es prefijo si |K| no pasa del prefijo
+     * común de la entrada y L. Coste O(profundidad + |entrada|) (más una
+     * comparación por candidata que acabe en bytes '\0' más allá de L).
+     *
+     * @param input Entrada
+     * @param matches Hojas que sí son prefijo de la entrada
+     */
+    void find_prefix_leaves(const string& input, vector<const PatriciaLeafNode*>& matches) const;
+
     /**
      * @brief Función auxiliar para recolectar posiciones del subárbol
-     * @param node Nodo actual
+     * @param p Raíz etiquetada del subárbol
      * @param positions Vector para almacenar posiciones
      */
-    void collect_positions(PatriciaTrieNode* node, vector<int>& positions);
+    void collect_positions(uintptr_t p, vector<int>& positions) const;
     
     /**
      * @brief Función auxiliar para recolectar palabras con posiciones
-     * @param node Nodo actual
+     *
+     * Las claves salen en orden lexicográfico porque el hijo del bit 0 se
+     * visita primero.
+     *
+     * @param p Raíz etiquetada del subárbol
      * @param results Vector para almacenar pares (palabra, posición)
      */
-    void collect_words(PatriciaTrieNode* node, vector<pair<string, int>>& results);
+    void collect_words(uintptr_t p, vector<pair<string, int>>& results) const;
 
 public:
     /**
@@ -126,6 +232,14 @@ public:
      */
     ~PatriciaTrie();
 
+    PatriciaTrie(const PatriciaTrie&) = delete;
+    PatriciaTrie& operator=(const PatriciaTrie&) = delete;
+
+    /**
+     * @brief Longitud máxima de una clave (el índice de byte de los nodos es de 32 bits)
+     */
+    static constexpr size_t MaxKeyLength = UINT32_MAX;
+
     /**
      * @brief Verifica si el árbol está vacío
      * 
@@ -154,7 +268,7 @@ public:
      * @brief Inserta una cadena en el árbol
      * 
      * Si la cadena ya existe, no se realiza ninguna acción.
-     * La cadena no puede estar vacía ni exceder los 32 caracteres.
+     * La cadena no puede estar vacía; no hay límite de longitud.
      * 
      * @param element Cadena a insertar
      */
@@ -182,13 +296,31 @@ public:
     
     /**
      * @brief Encuentra palabras que comienzan con un prefijo
+     *
+     * Coste O(|prefijo| + salida): solo se enumera el subárbol del prefijo.
+     * El prefijo vacío devuelve las posiciones de todo el árbol.
+     *
      * @param prefix Prefijo a buscar
      * @return Vector con las posiciones de palabras que comienzan con el prefijo
      */
     vector<int> starts_with_positions(const string& prefix);
+
+    /**
+     * @brief Indica si alguna clave empieza por el prefijo (el vacío: si hay claves)
+     *
+     * Coste O(|prefijo|), sin enumerar el subárbol; también vale para las
+     * claves insertadas sin posiciones.
+     *
+     * @param prefix Prefijo a buscar
+     * @return true si el subárbol del prefijo no está vacío
+     */
+    bool has_prefix(const string& prefix) const;
     
     /**
      * @brief Devuelve todas las palabras que empiezan por un prefijo
+     *
+     * Coste O(|prefijo| + salida), igual que starts_with_positions().
+     *
      * @param prefix Prefijo a buscar
      * @return Vector de pares (palabra, posición) que comienzan con el prefijo
      */
@@ -201,18 +333,32 @@ public:
     vector<pair<string, int>> get_words();
 
     /**
-     * @brief Obtiene el número máximo de bits soportados
-     * 
-     * @return Número máximo de bits (256 = 32 caracteres * 8 bits)
+     * @brief Clave más larga que es prefijo de la entrada
+     *
+     * Dos descensos por los bits de la entrada y una comparación con la hoja
+     * a la que llega: O(profundidad + |entrada|) (ver find_prefix_leaves()).
+     *
+     * @param input Entrada
+     * @return Longitud y posiciones de la clave; longitud 0 si no hay ninguna
      */
-    static int getMaxBits() { return MaxBits; }
+    PrefixMatch longest_prefix_match(const string& input) const;
 
     /**
-     * @brief Obtiene la longitud máxima de cadena soportada
-     * 
-     * @return Número máximo de caracteres (32)
+     * @brief Todas las claves que son prefijo de la entrada, de más corta a más larga
+     */
+    vector<PrefixMatch> all_prefix_matches(const string& input) const;
+
+    /**
+     * @brief Devuelve los contadores de instrumentación (vacíos sin TRIE_STATS)
+     * @return Copia de los contadores e histogramas de latencia
+     */
+    TrieStats stats() const;
+
+    /**
+     * @brief Perfil de memoria y forma del árbol
+     * @return Bytes por categoría e histogramas de profundidad y longitud de clave
      */
-    static int getMaxLength() { return MaxBits / 8; }
+    TrieProfile profile() const;
 };
 
 #endif // PATRICIA_H
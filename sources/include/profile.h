@@ -0,0 +1,68 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+using namespace std;
+
+/**
+ * @brief Informe de memòria i forma d'un trie construït
+ *
+ * Els bytes es reparteixen en:
+ * - node_header_bytes: camps propis del node (marques, objectes string/vector...)
+ * - child_table_bytes: taules o contenidors de fills
+ * - label_bytes: etiquetes o claus emmagatzemades fora del node
+ * - position_bytes: llistes de posicions
+ * - allocator_overhead_bytes: capçaleres i arrodoniment de malloc (estimat)
+ *
+ * Els histogrames són mapes valor -> nombre de nodes.
+ */
+struct TrieProfile {
+    string backend;
+
+    size_t nodes = 0;
+    size_t keys = 0;
+    size_t positions = 0;
+    size_t allocations = 0;
+
+    size_t node_header_bytes = 0;
+    size_t child_table_bytes = 0;
+    size_t label_bytes = 0;
+    size_t position_bytes = 0;
+    size_t allocator_overhead_bytes = 0;
+
+    size_t empty_child_slots = 0;   // entrades de taules de fills sense fill
+
+    map<size_t, size_t> fanout_histogram;
+    map<size_t, size_t> depth_histogram;
+    map<size_t, size_t> label_length_histogram;
+
+    /**
+     * @brief Suma de totes les categories de bytes
+     */
+    size_t total_bytes() const;
+
+    /**
+     * @brief Registra una reserva de memòria i n'acumula la sobrecàrrega estimada
+     * @param bytes Mida demanada a l'allocator
+     */
+    void add_allocation(size_t bytes);
+
+    /**
+     * @brief Bytes de heap d'un string (0 si cap dins el buffer intern)
+     */
+    static size_t string_heap_bytes(const string& s);
+
+    /**
+     * @brief Informe llegible per a la consola
+     */
+    string to_string() const;
+
+    /**
+     * @brief Informe en JSON
+     */
+    string to_json() const;
+};
+
+#endif // PROFILE_H
@@ -0,0 +1,32 @@
+#ifndef QUERY_PROTOCOL_H
+#define QUERY_PROTOCOL_H
+
+#include <string>
+#include <vector>
+#include "radixDone.h"
+using namespace std;
+
+/**
+ * @brief Respostes del protocol de línies del servidor de consultes
+ *
+ * Una petició per línia i una resposta per línia (sense el '\n'):
+ *   S <clau>        -> <posicions> seguit de fins a 10 posicions
+ *   C <prefix>      -> posicions de les claus que comencen pel prefix
+ *   A <k> <prefix>  -> les k primeres claus amb el prefix, separades per tabuladors
+ *   L <entrada>     -> longitud de la clau més llarga que és prefix de l'entrada
+ *   altres          -> ERR <missatge>
+ *
+ * En un índex de sufixos les claus són sufixos del text: poden ser tan llargues
+ * com el text i contenir salts de línia, que trencarien l'enquadrament, així
+ * que amb 'suffixes' A respon ERR (S, C i L només retornen nombres).
+ */
+string answer_query(const RadixTrie& trie, const string& line, bool suffixes);
+
+/**
+ * @brief Treu de l'inici de 'input' com a molt 'max_lines' línies completes i
+ * les afegeix a 'lines' sense el '\n' (ni el '\r' d'abans, si n'hi ha)
+ * @return Indica si a 'input' hi queden més línies completes
+ */
+bool take_lines(string& input, size_t max_lines, vector<string>& lines);
+
+#endif // QUERY_PROTOCOL_H
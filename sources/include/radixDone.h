@@ -1,50 +1,281 @@
 #ifndef RADIX_H
 #define RADIX_H
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 #include <utility>
 #include <memory>
 #include <unordered_map>
+#include "stats.h"
+#include "profile.h"
+#include "trie.h"
 using namespace std;
 
 /**
  * @brief Implementació d'un Radix Trie (Trie compacte)
+ *
+ * Les etiquetes no són strings propis de cada node sinó referències
+ * (desplaçament, longitud) a un buffer compartit:
+ * - el text indexat per init(), del qual totes les etiquetes són subcadenes;
+ * - un pool d'etiquetes per a les paraules inserides amb insert();
+ * - o el mateix node, si l'etiqueta té com a molt Label::InlineCapacity bytes.
+ * Així dividir un node és aritmètica d'enters i no reserva cap string.
+ *
+ * Les fulles dels sufixos tenen etiquetes obertes (OpenLabel): arriben fins al
+ * final del text indexat, de manera que append() les allarga sense tocar-les.
+ *
+ * Opcionalment (RadixTrie(true)) es manté un índex hash de les paraules
+ * inserides amb insert(): clau sencera -> node on acaba. search() hi fa una
+ * sola consulta en lloc de baixar per l'arbre; starts_with() i autocomplete()
+ * continuen fent servir el trie. Els sufixos de init()/append() no hi són
+ * (les seves claus creixen amb append()), i per a aquests search() baixa per
+ * l'arbre si la consulta no hi troba res.
+ *
+ * starts_with(), autocomplete() i get_words() amb més de 2 * ParallelGrain
+ * resultats es fan en paral·lel al ThreadPool compartit: amb els comptadors
+ * del subarbre se sap on va el resultat de cada fill, i cada subarbre de com
+ * a mínim ParallelGrain posicions és una tasca que escriu el seu tros del
+ * vector. L'ordre és el mateix que el del recorregut seqüencial.
  */
+class TaskGroup;
+
 class RadixTrie {
+    friend class CompactRadixTrie;
+
+public:
+    /**
+     * @brief Rep cada clau d'un recorregut ordenat amb les seves posicions;
+     * si retorna false el recorregut s'atura
+     */
+    using RangeVisitor = function<bool(const string& key, const vector<int>& positions)>;
+
 private:
+    enum LabelSource : uint32_t { InlineLabel = 0, TextLabel = 1, PoolLabel = 2, OpenLabel = 3 };
+
+    /**
+     * @brief Etiqueta d'una aresta (16 bytes).
+     * Si source és InlineLabel els bytes són a 'bytes'; si no, 'offset' indica
+     * on comença dins del text indexat o del pool d'etiquetes. Una OpenLabel és
+     * una TextLabel que acaba al final del text: 'length' no s'hi fa servir
+     * (vegeu label_length()).
+     */
+    struct Label {
+        static constexpr size_t InlineCapacity = 12;
+
+        uint32_t length : 30;
+        uint32_t source : 2;
+        union {
+            uint32_t offset;
+            char bytes[InlineCapacity];
+        };
+
+        Label() : length(0), source(InlineLabel), offset(0) {}
+    };
+
+    struct RadixNode;
+
+    /**
+     * @brief Fills d'un node, en un vector ordenat pel primer byte de
+     * l'etiqueta (sense signe, com compara string). Recórrer-los dóna les
+     * claus en ordre lexicogràfic; la cerca és binària i, amb els pocs fills
+     * habituals, ocupa menys que un unordered_map. Té la mateixa interfície
+     * que el map que substitueix (find, operator[], erase, iteració).
+     */
+    class ChildList {
+    public:
+        using Entry = pair<char, unique_ptr<RadixNode>>;
+        using iterator = vector<Entry>::iterator;
+        using const_iterator = vector<Entry>::const_iterator;
+
+        iterator find(char c);
+        const_iterator find(char c) const;
+        unique_ptr<RadixNode>& operator[](char c);  // insereix una entrada buida si no hi és
+        void erase(char c);
+
+        iterator begin() { return entries.begin(); }
+        iterator end() { return entries.end(); }
+        const_iterator begin() const { return entries.begin(); }
+        const_iterator end() const { return entries.end(); }
+        size_t size() const { return entries.size(); }
+        bool empty() const { return entries.empty(); }
+        size_t capacity() const { return entries.capacity(); }
+
+    private:
+        vector<Entry> entries;
+    };
+
     /**
      * @brief Node intern del Radix Trie.
-     * label: El substring comprimit.
-     * children: Map de char (primer caràcter de l'etiqueta del fill) a punter al fill.
+     * label: El substring comprimit (referència al text/pool o inline).
+     * children: Fills ordenats pel primer caràcter de la seva etiqueta.
      * positions: Llista de posicions on comença la clau (paraula/sufix).
      * is_end_of_key: Marca si aquest node representa el final d'una clau vàlida.
+     * is_word: La clau s'ha inserit amb insert() (pot no tenir posicions): no
+     * la perd quan append() en treu els sufixos tancats.
+     * parent, subtree_keys, subtree_positions: comptadors del subarbre (node
+     * inclòs), que es propaguen cap a l'arrel a cada canvi (add_to_counts()).
      */
     struct RadixNode {
-        string label;
+        Label label;
         // Utilitzem unique_ptr per a la gestió automàtica de la memòria
-        unordered_map<char, unique_ptr<RadixNode>> children; 
+        ChildList children;
         vector<int> positions;
+        RadixNode* parent = nullptr;
+        uint32_t subtree_keys = 0;
+        uint32_t subtree_positions = 0;
         bool is_end_of_key;
+        bool is_word = false;
 
         // Constructor
-        RadixNode(const string& l = "") : label(l), is_end_of_key(false) {}
+        RadixNode() : is_end_of_key(false) {}
     };
     
     unique_ptr<RadixNode> root;
+    string source_text;   // Text indexat per init() (etiquetes TextLabel)
+    string label_pool;    // Etiquetes llargues de paraules inserides (PoolLabel)
+    vector<int> closed_suffixes;  // Sufixos que no acaben en una fulla oberta
+    unique_ptr<unordered_map<string, RadixNode*>> exact_index;  // Paraula -> node final (opcional)
+    bool parallel_enumeration = true;
+
+#ifdef TRIE_STATS
+    mutable TrieStats counters;
+#endif
+
+    // Gestió de les etiquetes:
+    const char* label_data(const Label& label) const;
+    size_t label_length(const Label& label) const {
+        return label.source == OpenLabel ? source_text.length() - label.offset : label.length;
+    }
+    Label make_label(const char* key, size_t length, size_t text_offset);
+    void slice_label(Label& label, size_t from, size_t length) const;
+    Label join_labels(const Label& head, const Label& tail);
+
+    /**
+     * @brief Insereix una clau sota el node 'start' (la clau no inclou el camí fins a start).
+     * Si text_offset != string::npos la clau és source_text[text_offset, text_offset + length)
+     * i les etiquetes noves hi apunten; si no, les etiquetes llargues es copien al pool.
+     * @return Node on acaba la clau (els nodes no es mouen en dividir-ne d'altres)
+     */
+    RadixNode* insert_key(RadixNode* start, const char* key, size_t length, size_t text_offset, int position);
+
+    /**
+     * @brief Converteix l'etiqueta oberta d'un node en una de longitud fixa
+     * (una clau inserida hi passa o hi acaba, així que ja no pot créixer)
+     */
+    void close_label(RadixNode* node);
+
+    /**
+     * @brief Suma claus i posicions als comptadors de 'node' i de tots els seus avantpassats
+     */
+    static void add_to_counts(RadixNode* node, int keys, int positions);
+
+    /**
+     * @brief Substitueix 'node' (sense clau i amb un sol fill) pel seu fill
+     * dins de 'parent', ajuntant-ne les etiquetes. El fill no es mou.
+     */
+    void merge_with_child(RadixNode* parent, RadixNode* node);
+
+    /**
+     * @brief Treu de l'índex hash la paraula que hi apunta a 'node' (si n'hi
+     * ha): s'ha de cridar abans d'alliberar un node
+     */
+    void unindex(const RadixNode* node);
+
+    /**
+     * @brief Funció auxiliar d'append(): treu la posició dels sufixos de closed_suffixes
+     * del node on acaben, perquè append() els continuï des d'allà.
+     * @return Parells (node on acaba el sufix, posició del sufix)
+     */
+    vector<pair<RadixNode*, int>> detach_closed_suffixes();
+
+    /**
+     * @brief Baixa per l'arbre seguint una clau.
+     * @param key Clau (no buida)
+     * @param depth Sortida: longitud de la clau abans de l'etiqueta del node retornat
+     * @return Node l'etiqueta del qual conté el final de la clau, o nullptr si no hi és
+     */
+    RadixNode* find_node(const string& key, size_t& depth) const;
     
     // Funcions auxiliars privades per a recorreguts:
     void collect_words_recursive(RadixNode* node, string current_prefix, vector<pair<string, int>>& results) const;
     void collect_positions_recursive(RadixNode* node, vector<int>& positions) const;
 
+    // Recorreguts paral·lels: escriuen el subarbre a partir de 'out', on hi
+    // caben node->subtree_positions resultats, i encuen a 'group' els fills
+    // grans ('path' és la clau abans de l'etiqueta del node)
+    void write_positions(const RadixNode* node, int* out, TaskGroup& group) const;
+    void write_words(const RadixNode* node, string& path, pair<string, int>* out, TaskGroup& group) const;
+    bool enumerate_in_parallel(const RadixNode* node) const;
+    void profile_recursive(const RadixNode* node, size_t depth, TrieProfile& report) const;
+    bool range_recursive(const RadixNode* node, string& path, const string& lo, const string& hi,
+                         bool check_lo, bool check_hi, const RangeVisitor& visit) const;
+
+    /**
+     * @brief Clau d'un node, pujant pels pares (cost O(profunditat) en nodes i
+     * la longitud de la clau en bytes, sense baixar per cap subarbre)
+     */
+    string path_of(const RadixNode* node) const;
+
+    // Funcions auxiliars de les analítiques de subcadenes ('depth' és la
+    // longitud de la clau del node)
+    void deepest_repeat(const RadixNode* node, size_t depth, const RadixNode*& best, size_t& best_depth) const;
+    void frequent_nodes(const RadixNode* node, size_t depth, size_t min_len, size_t k,
+                        vector<pair<size_t, const RadixNode*>>& heap) const;
+    void common_substring(const RadixNode* node, size_t depth, size_t split, size_t& min_a, bool& has_b,
+                          size_t& best_offset, size_t& best_length) const;
+
 public:
     // Constructor i Destructor
     RadixTrie();
+
+    /**
+     * @param exact_index Si és true, manté l'índex hash de paraules per a search()
+     */
+    explicit RadixTrie(bool exact_index);
     ~RadixTrie() = default; // unique_ptr s'encarrega de l'alliberament
 
     // Funcions d'indexació
     void init(const string& text);
+
+    /**
+     * @brief Afegeix text al final de l'índex de sufixos sense reconstruir-lo.
+     * Les posicions noves comencen a la longitud anterior del text. Els sufixos
+     * antics que acaben en una fulla s'allarguen sols (etiqueta oberta); només
+     * cal continuar els que acaben en un node intern (prefixos d'una altra clau).
+     * El cost és proporcional al text nou més la longitud d'aquests sufixos, que
+     * és petita excepte en textos molt periòdics. Les claus inserides amb
+     * insert() no es modifiquen.
+     * @param text_chunk Text a afegir
+     */
+    void append(const string& text_chunk);
     void insert(const string& word, int position);
+
+    /**
+     * @brief Elimina una clau amb totes les seves posicions. Si el node queda
+     * sense clau es treu (fulla) o es fusiona amb el seu únic fill, i el trie
+     * continua compacte. Actualitza l'índex hash si n'hi ha.
+     * @return true si la clau hi era
+     */
+    bool erase(const string& word);
+
+    /**
+     * @brief Indica si es manté l'índex hash de paraules
+     */
+    bool has_exact_index() const { return exact_index != nullptr; }
+
+    /**
+     * @brief Posicions mínimes d'un subarbre per fer-ne una tasca
+     */
+    static constexpr uint32_t ParallelGrain = 8192;
+
+    /**
+     * @brief Activa o desactiva les enumeracions paral·leles (actives per
+     * defecte; amb STATS=1 sempre són seqüencials perquè els comptadors no
+     * són thread-safe)
+     */
+    void set_parallel_enumeration(bool enabled) { parallel_enumeration = enabled; }
     
     // Funcions de cerca (Declarades com a 'const' per al Wrapper i bones pràctiques)
     vector<int> search(const string& word) const; 
@@ -52,6 +283,89 @@ public:
     vector<pair<string, int>> autocomplete(const string& prefix) const;
     vector<pair<string, int>> get_words() const;
 
+    /**
+     * @brief Nombre de claus que comencen pel prefix, sense recórrer el
+     * subarbre: cost proporcional a la longitud del prefix.
+     */
+    size_t count_prefix(const string& prefix) const;
+
+    /**
+     * @brief Nombre de posicions de les claus que comencen pel prefix (la mida
+     * de starts_with(prefix)), també en O(|prefix|).
+     */
+    size_t count_positions(const string& prefix) const;
+
+    /**
+     * @brief Clau més llarga que és prefix de l'entrada, en una sola baixada
+     * @return Longitud i posicions de la clau; longitud 0 si no n'hi ha cap
+     */
+    PrefixMatch longest_prefix_match(const string& input) const;
+
+    /**
+     * @brief Totes les claus que són prefix de l'entrada, de més curta a més llarga
+     */
+    vector<PrefixMatch> all_prefix_matches(const string& input) const;
+
+    // Accés ordenat (ordre lexicogràfic per bytes sense signe, com string).
+    // Cada clau compta un cop, tingui les posicions que tingui.
+
+    /**
+     * @brief Nombre de claus estrictament menors que 'key' (no cal que hi sigui).
+     * Cost O(profunditat x fills per node) gràcies als comptadors del subarbre.
+     */
+    size_t rank(const string& key) const;
+
+    /**
+     * @brief k-èsima clau en ordre (començant per 0)
+     * @return La clau, o un string buit si k >= count_prefix("")
+     */
+    string select(size_t k) const;
+
+    /**
+     * @brief Recorre en ordre les claus de [lo, hi) amb les seves posicions,
+     * sense visitar els subarbres de fora del rang: cost O(profunditat) més
+     * la sortida. Si 'hi' és buit no hi ha límit superior.
+     * @param visit Es crida per cada clau; si retorna false s'atura (paginació)
+     */
+    void for_each_in_range(const string& lo, const string& hi, const RangeVisitor& visit) const;
+
+    /**
+     * @brief Parells (clau, posició) de les claus de [lo, hi), en ordre
+     */
+    vector<pair<string, int>> range(const string& lo, const string& hi) const;
+
+    // Analítiques de subcadenes sobre l'índex de sufixos de init()/append()
+    // (cada posició és l'inici d'un sufix). Totes fan servir els comptadors
+    // del subarbre i com a molt un recorregut de l'arbre, sense comparar
+    // parells de sufixos.
+
+    /**
+     * @brief Vegades que 'pattern' apareix al text indexat, en O(|pattern|)
+     */
+    size_t count_occurrences(const string& pattern) const { return count_positions(pattern); }
+
+    /**
+     * @brief Subcadena més llarga que apareix almenys dos cops (poden solapar-se)
+     * @return La subcadena, o un string buit si cap byte es repeteix
+     */
+    string longest_repeated_substring() const;
+
+    /**
+     * @brief Les k subcadenes de longitud >= min_len que apareixen més cops
+     * (almenys dos). Totes les subcadenes que acaben dins de la mateixa
+     * etiqueta tenen les mateixes ocurrències: de cada grup es retorna la més
+     * llarga, la clau del node.
+     * @return Parells (subcadena, ocurrències), de més a menys freqüent
+     */
+    vector<pair<string, size_t>> most_frequent_substrings(size_t k, size_t min_len) const;
+
+    /**
+     * @brief Subcadena comuna més llarga de dos textos, amb un índex de
+     * sufixos de a + b: és el node més profund amb sufixos de tots dos
+     * textos, amb la longitud limitada perquè els sufixos de 'a' no passin a 'b'
+     */
+    static string longest_common_substring(const string& a, const string& b);
+
     // Funcions de compatibilitat (si són necessàries a 'main.cpp')
     void insert(const string& word) { insert(word, -1); } // Posició fictícia
     bool search_bool(const string& word) const { return !search(word).empty(); }
@@ -67,6 +381,18 @@ public:
      * @return true si el trie està buit.
      */
     bool empty() const;
+
+    /**
+     * @brief Retorna els comptadors d'instrumentació (buits sense TRIE_STATS).
+     * @return Còpia dels comptadors i histogrames de latència.
+     */
+    TrieStats stats() const;
+
+    /**
+     * @brief Perfil de memòria i forma del trie.
+     * @return Bytes per categoria, cubetes buides i histogrames de fanout/profunditat/etiqueta.
+     */
+    TrieProfile profile() const;
     
     // Si RadixTrie ha d'implementar la interfície 'Trie', haureu d'afegir:
     /*
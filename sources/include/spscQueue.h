@@ -0,0 +1,93 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Cua acotada sense locks per a un sol productor i un sol consumidor
+ *
+ * Buffer circular de mida potència de 2. El productor només escriu 'tail' i
+ * el consumidor només escriu 'head'; cadascun guarda una còpia local de
+ * l'índex de l'altre i només el torna a llegir (acquire) quan la cua sembla
+ * plena o buida, de manera que en el cas normal no hi ha trànsit de cache
+ * entre els dos fils. Les operacions no bloquegen: qui les crida decideix com
+ * esperar (i ho pot comptar com a backpressure).
+ *
+ * @tparam T Tipus dels elements (movible i construïble per defecte)
+ */
+template <class T>
+class SpscQueue {
+public:
+    /**
+     * @param capacity Capacitat mínima; s'arrodoneix a la potència de 2 següent
+     */
+    explicit SpscQueue(size_t capacity) : slots(round_up(capacity)), mask(slots.size() - 1) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Afegeix un element (només el productor)
+     * @return false si la cua és plena; en aquest cas 'item' no es mou
+     */
+    bool try_push(T& item) {
+        size_t t = tail.load(memory_order_relaxed);
+        if (t - head_cache == slots.size()) {
+            head_cache = head.load(memory_order_acquire);
+            if (t - head_cache == slots.size()) return false;
+        }
+        slots[t & mask] = std::move(item);
+        tail.store(t + 1, memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Treu un element (només el consumidor)
+     * @return false si la cua és buida
+     */
+    bool try_pop(T& item) {
+        size_t h = head.load(memory_order_relaxed);
+        if (h == tail_cache) {
+            tail_cache = tail.load(memory_order_acquire);
+            if (h == tail_cache) return false;
+        }
+        item = std::move(slots[h & mask]);
+        head.store(h + 1, memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief El productor indica que no hi haurà més elements
+     */
+    void close() { finished.store(true, memory_order_release); }
+
+    /**
+     * @brief Cert si el productor ha tancat la cua. Si ho és i try_pop() falla
+     * després d'haver-ho comprovat, ja no arribaran més elements.
+     */
+    bool closed() const { return finished.load(memory_order_acquire); }
+
+    size_t capacity() const { return slots.size(); }
+
+private:
+    static size_t round_up(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        return size;
+    }
+
+    vector<T> slots;
+    const size_t mask;
+
+    // Cada índex en una línia de cache pròpia, amb la còpia que en fa l'altre fil
+    alignas(64) atomic<size_t> head{0};  // escrit pel consumidor
+    size_t tail_cache = 0;               // còpia del consumidor
+    alignas(64) atomic<size_t> tail{0};  // escrit pel productor
+    size_t head_cache = 0;               // còpia del productor
+    alignas(64) atomic<bool> finished{false};
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,124 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+using namespace std;
+
+/**
+ * @brief Histograma de latències logarítmic-lineal (estil HDR)
+ *
+ * Els valors (en nanosegons) es classifiquen per potència de 2 i cada
+ * potència es divideix en 2^SubBits subcubetes lineals, de manera que
+ * l'error relatiu de qualsevol percentil és inferior a 1/2^SubBits (~6%)
+ * sigui quina sigui la magnitud, amb una mida fixa de memòria.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned SubBits = 4;
+    static constexpr size_t SubBuckets = size_t(1) << SubBits;
+    static constexpr size_t Buckets = (64 - SubBits + 1) * SubBuckets;
+
+    LatencyHistogram();
+
+    /**
+     * @brief Registra una mostra
+     * @param ns Latència en nanosegons
+     */
+    void record(uint64_t ns);
+
+    /**
+     * @brief Valor aproximat del percentil p
+     * @param p Percentil entre 0 i 100
+     * @return Límit superior de la cubeta que conté el percentil (ns)
+     */
+    uint64_t percentile(double p) const;
+
+    uint64_t count() const { return samples; }
+    uint64_t min() const { return samples ? lowest : 0; }
+    uint64_t max() const { return highest; }
+    double mean() const { return samples ? double(total) / samples : 0.0; }
+
+    /**
+     * @brief Buida el histograma
+     */
+    void reset();
+
+    /**
+     * @brief Serialitza el histograma: resum, percentils i cubetes no buides
+     */
+    string to_json() const;
+
+private:
+    array<uint64_t, Buckets> counts;
+    uint64_t samples;
+    uint64_t total;
+    uint64_t lowest;
+    uint64_t highest;
+
+    static size_t bucket_of(uint64_t ns);
+    static uint64_t bucket_upper(size_t bucket);
+};
+
+/**
+ * @brief Comptadors del camí calent d'un backend
+ *
+ * Només s'actualitzen si es compila amb -DTRIE_STATS (make STATS=1). Sense
+ * aquesta opció les macros TRIE_STAT/TRIE_STAT_TIMER no generen codi i els
+ * backends ni tan sols guarden els comptadors. No són thread-safe: cada
+ * backend els actualitza des del fil que fa l'operació.
+ */
+struct TrieStats {
+    uint64_t lookups = 0;           // search + starts_with + autocomplete
+    uint64_t nodes_visited = 0;     // nodes travessats per les consultes
+    uint64_t bytes_compared = 0;    // bytes d'etiqueta/clau comparats
+    uint64_t splits = 0;            // nodes dividits (o branques noves) en inserir
+    uint64_t positions_copied = 0;  // posicions copiades als resultats
+    uint64_t allocations = 0;       // nodes reservats
+
+    LatencyHistogram insert_latency;
+    LatencyHistogram search_latency;
+    LatencyHistogram starts_with_latency;
+    LatencyHistogram autocomplete_latency;
+
+    /**
+     * @brief Posa tots els comptadors i histogrames a zero
+     */
+    void reset();
+
+    /**
+     * @brief Serialitza els comptadors i histogrames en JSON
+     */
+    string to_json() const;
+};
+
+/**
+ * @brief Mesura el temps de vida de l'objecte i el registra en un histograma
+ */
+class ScopedLatency {
+public:
+    explicit ScopedLatency(LatencyHistogram& h) : histogram(h), start(chrono::steady_clock::now()) {}
+    ~ScopedLatency() {
+        auto ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+        histogram.record(static_cast<uint64_t>(ns));
+    }
+
+private:
+    LatencyHistogram& histogram;
+    chrono::steady_clock::time_point start;
+};
+
+#define TRIE_STAT_CONCAT_(a, b) a##b
+#define TRIE_STAT_CONCAT(a, b) TRIE_STAT_CONCAT_(a, b)
+
+#ifdef TRIE_STATS
+#define TRIE_STAT(expr) do { expr; } while (0)
+#define TRIE_STAT_TIMER(histogram) ScopedLatency TRIE_STAT_CONCAT(trie_stat_timer_, __LINE__)(histogram)
+#else
+#define TRIE_STAT(expr) do { } while (0)
+#define TRIE_STAT_TIMER(histogram) do { } while (0)
+#endif
+
+#endif // STATS_H
@@ -0,0 +1,141 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Pool de fils amb robatori de feina (work stealing)
+ *
+ * Cada fil té la seva cua de tasques. Una tasca que en crea d'altres les posa
+ * a la cua del seu fil i el fil les treu per darrere (LIFO: les més recents,
+ * amb les dades encara a la cache); un fil sense feina en roba per davant de
+ * les cues dels altres (FIFO: les més antigues, normalment les més grans). Les
+ * tasques que arriben de fora del pool es reparteixen entre les cues per
+ * torns. Les cues són deques amb un mutex cadascuna: el mutex d'una cua només
+ * es disputa quan algú hi roba.
+ *
+ * Les tasques no haurien de bloquejar-se esperant altres tasques del pool (si
+ * tots els fils esperen, no en queda cap per fer la feina), llevat de les d'un
+ * TaskGroup, que wait() pot fer ell mateix.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param threads Nombre de fils (0: un per nucli)
+     */
+    explicit ThreadPool(size_t threads = 0);
+
+    /**
+     * @brief Acaba les tasques pendents i espera els fils
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Encua una tasca sense resultat (no ha de llançar excepcions:
+     * per a això hi ha submit())
+     */
+    void post(function<void()> task);
+
+    /**
+     * @brief Encua una tasca i en retorna el resultat (o l'excepció) en un future
+     */
+    template <class F>
+    future<invoke_result_t<F>> submit(F&& f) {
+        using Result = invoke_result_t<F>;
+        // function<> ha de ser copiable i packaged_task no ho és
+        auto task = make_shared<packaged_task<Result()>>(std::forward<F>(f));
+        future<Result> result = task->get_future();
+        post([task] { (*task)(); });
+        return result;
+    }
+
+    /**
+     * @brief Executa una tasca pendent des del fil actual (la més recent de la
+     * seva cua si és un fil del pool, o en roba una); per esperar ajudant
+     * @return false si no hi havia cap tasca
+     */
+    bool run_pending_task();
+
+    size_t size() const { return threads.size(); }
+
+    /**
+     * @brief Pool compartit del procés, amb un fil per nucli
+     */
+    static ThreadPool& shared();
+
+private:
+    struct alignas(64) Queue {
+        mutex lock;
+        deque<function<void()>> tasks;
+    };
+
+    vector<unique_ptr<Queue>> queues;
+    vector<thread> threads;
+    atomic<size_t> queued{0};       // tasques encuades i encara no agafades
+    atomic<size_t> next_queue{0};   // repartiment per torns de les tasques de fora
+    mutex sleep_lock;
+    condition_variable wake;
+    bool stopping = false;
+
+    bool try_run_one(size_t self, bool owner);
+    void worker_loop(size_t index);
+};
+
+/**
+ * @brief Grup de tasques fork-join sobre un ThreadPool
+ *
+ * run() posa la tasca a la cua del grup i encua al pool un executor que en
+ * treu una. wait() executa, des del fil que espera, les tasques del grup que
+ * encara no ha agafat ningú (les més recents primer) i, quan no en queden, es
+ * bloqueja fins que acaben les que s'estan executant en altres fils. Només
+ * executa tasques del propi grup: una tasca qualsevol del pool podria
+ * necessitar un recurs que el fil que espera té agafat (p. ex. el lock
+ * exclusiu d'AsyncTrie::insert mentre una consulta fa fork-join). Es pot
+ * cridar des d'una tasca: cada tasca del grup o és a la cua, i la fa qui
+ * espera, o ja s'executa en algun fil. La primera excepció d'una tasca es
+ * torna a llançar a wait().
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::shared());
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(function<void()> task);
+    void wait();
+
+private:
+    /**
+     * @brief Estat compartit amb els executors encuats al pool, que poden
+     * arribar a executar-se (sense feina) després que el grup desaparegui
+     */
+    struct State {
+        mutex lock;
+        condition_variable changed;     // tasca nova o pending a 0
+        deque<function<void()>> tasks;  // encara no agafades
+        size_t pending = 0;             // encuades o en execució
+        exception_ptr error;
+
+        void execute(function<void()>& task);
+    };
+
+    ThreadPool& pool;
+    shared_ptr<State> state;
+};
+
+#endif // THREAD_POOL_H
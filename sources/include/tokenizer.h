@@ -0,0 +1,84 @@
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Terme trobat pel Tokenizer
+ */
+struct Token {
+    string_view text;  // terme en minúscules (apunta al buffer del Tokenizer)
+    size_t offset;     // posició del primer byte al text original (més el desplaçament base)
+};
+
+/**
+ * @brief Tokenitzador i normalitzador vectoritzat
+ *
+ * Un terme és una seqüència de lletres i dígits ASCII i de bytes >= 0x80
+ * (per no partir caràcters UTF-8), llevat de la puntuació U+2000-U+206F
+ * (cometes tipogràfiques, guions llargs...) i de la marca d'ordre de bytes,
+ * que separen com qualsevol altre signe. Són les mateixes regles que fa
+ * servir DocumentIndex.
+ *
+ * Es treballa en dues passades:
+ * 1. Classificació: per cada bloc de 16 (SSE2) o 32 (AVX2) bytes es calcula
+ *    amb comparacions vectorials quins bytes són de terme i es passen les
+ *    majúscules ASCII a minúscules, tot escrivint en un buffer intern; el
+ *    resultat és una màscara d'1 bit per byte.
+ * 2. Fronteres: els inicis i finals de terme són els canvis de bit de la
+ *    màscara, i es recorren 64 bytes cada cop amb count-trailing-zeros.
+ * La puntuació Unicode (poc freqüent) es corregeix a part amb memchr.
+ *
+ * La ISA es tria en temps d'execució (la millor que suporti la CPU) i es pot
+ * forçar per comparar-les; totes donen exactament els mateixos termes.
+ */
+class Tokenizer {
+public:
+    enum class Isa { Scalar, SSE2, AVX2 };
+
+    /**
+     * @brief Tokenitzador amb la millor ISA disponible
+     */
+    Tokenizer();
+
+    /**
+     * @brief Tokenitzador amb una ISA concreta (Scalar si la CPU no la suporta)
+     */
+    explicit Tokenizer(Isa isa);
+
+    /**
+     * @brief Parteix un text en termes normalitzats
+     * @param text Text (no cal que acabi en zero)
+     * @param length Bytes del text
+     * @param base_offset Valor que se suma a l'offset de cada terme
+     * @return Termes en ordre; les vistes són vàlides fins a la crida següent
+     */
+    const vector<Token>& tokenize(const char* text, size_t length, size_t base_offset = 0);
+    const vector<Token>& tokenize(const string& text, size_t base_offset = 0) {
+        return tokenize(text.data(), text.length(), base_offset);
+    }
+
+    Isa isa() const { return selected; }
+
+    static Isa best_isa();
+    static bool supported(Isa isa);
+    static const char* isa_name(Isa isa);
+
+private:
+    Isa selected;
+    string buffer;           // text amb les majúscules ASCII passades a minúscules
+    vector<uint64_t> masks;  // bit i de masks[i / 64]: el byte i és de terme
+    vector<Token> tokens;
+
+    void classify_scalar(const char* text, size_t from, size_t length);
+    void classify_sse2(const char* text, size_t length);
+    void classify_avx2(const char* text, size_t length);
+    void clear_separators(const char* text, size_t length);
+    void extract_tokens(size_t length, size_t base_offset);
+};
+
+#endif // TOKENIZER_H
@@ -6,6 +6,15 @@
 #include <vector>
 using namespace std;
 
+/**
+ * @brief Clau guardada que és prefix d'una entrada (longest_prefix_match() i
+ * all_prefix_matches() dels backends)
+ */
+struct PrefixMatch {
+    size_t length = 0;      // bytes de la clau (0: cap clau és prefix de l'entrada)
+    vector<int> positions;  // posicions de la clau
+};
+
 /**
  * @brief Classe base abstracta per als diferents tipus de Trie
  * 
@@ -0,0 +1,431 @@
+#include "../include/naive.h"
+#include "../include/patricia.h"
+#include "../include/radixDone.h"
+#include "../include/compactRadix.h"
+#include "../include/bitRadix.h"
+#include "../include/filteredTrie.h"
+#include "../include/cachedTrie.h"
+#include "../include/asyncTrie.h"
+#include "../include/intLpm.h"
+#include "../include/tokenizer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// Benchmark dels índexs de sufixos: construeix cada backend amb init(text)
+// sobre els primers N caràcters d'un fitxer i mesura el temps de construcció
+// i de cerca.
+//
+// Ús: bench <fitxer> [-n max_caracters] [-b backends] [-s]
+//   backends: combinació de 'n' (NaiveTrie), 'p' (PatriciaTrie), 'r' (RadixTrie),
+//             'c' (CompactRadixTrie amb cada layout; init = compactar)
+//             i '1', '2', '4', '8' (BitRadixTrie amb aquests bits per nivell)
+//             'h': RadixTrie de paraules amb i sense índex hash (search exacte)
+//             'f': NaiveTrie de paraules amb i sense filtre de Bloom (FilteredTrie)
+//             'l': longest_prefix_match() sobre les paraules del text i IntLpmTable
+//             'k': autocompletat (10 paraules) amb i sense CachedTrie, amb prefixos esbiaixats
+//             'y': get_words_with_prefix() de cada lletra, seqüencial i amb AsyncTrie
+//             'e': get_words() de RadixTrie i NaiveTrie de paraules, en paral·lel i en un fil
+//   -s: bolca stats() en JSON per a n/p/r (cal compilar amb make STATS=1)
+
+using Clock = chrono::steady_clock;
+
+static double elapsed_ms(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+static bool read_file(const string& filename, string& text) {
+    ifstream file(filename, ios::binary);
+    if (!file.is_open()) {
+        cout << "Error: No s'ha pogut obrir el fitxer " << filename << endl;
+        return false;
+    }
+    ostringstream buffer;
+    buffer << file.rdbuf();
+    text = buffer.str();
+    return true;
+}
+
+// Genera consultes deterministes: subcadenes del text (encerts) i cadenes
+// que no hi apareixen (errors)
+static vector<string> make_queries(const string& text) {
+    vector<string> queries;
+    if (text.empty()) return queries;
+    size_t step = max<size_t>(1, text.length() / 200);
+    for (size_t i = 0; i < text.length(); i += step) {
+        size_t len = 3 + (i % 8);
+        queries.push_back(text.substr(i, len));
+    }
+    for (const char* miss : {"eqzduw", "zutfjjuc", "tbsiurohqz", "qqqqq", "xyzzy"}) {
+        queries.push_back(miss);
+    }
+    return queries;
+}
+
+static void report(const string& name, double build_ms, double search_ns,
+                   double prefix_ns, size_t hits) {
+    cout << "  " << name << ":\n";
+    cout << "    init:        " << build_ms << " ms\n";
+    cout << "    search:      " << search_ns << " ns/consulta (" << hits << " encerts)\n";
+    cout << "    starts_with: " << prefix_ns << " ns/consulta\n";
+}
+
+// Mesura el temps mitjà per consulta d'una funció sobre totes les consultes
+static double time_queries(const vector<string>& queries, const function<size_t(const string&)>& query,
+                           size_t& hits) {
+    hits = 0;
+    auto start = Clock::now();
+    for (const string& q : queries) {
+        if (query(q) > 0) ++hits;
+    }
+    return elapsed_ms(start) * 1e6 / queries.size();
+}
+
+// Executa el benchmark sobre un BitRadixTrie<Bits> i n'informa la memòria
+template <unsigned Bits>
+static void bench_bit_radix(const string& text, const vector<string>& queries) {
+    BitRadixTrie<Bits> trie;
+    size_t hits, prefix_hits;
+    auto start = Clock::now();
+    trie.init(text);
+    double build = elapsed_ms(start);
+    double s = time_queries(queries, [&](const string& q) { return trie.search(q).size(); }, hits);
+    double p = time_queries(queries, [&](const string& q) { return trie.starts_with(q).size(); }, prefix_hits);
+    report("BitRadixTrie<" + to_string(Bits) + ">", build, s, p, hits);
+    cout << "    nodes:       " << trie.node_count() << " (" << trie.memory_bytes() / 1024 << " KB)\n";
+}
+
+// search() exacte sobre les paraules del text inserides amb insert(), amb
+// l'índex hash del RadixTrie i sense
+static void bench_exact_index(const string& text) {
+    vector<string> words;
+    Tokenizer tokenizer;
+    for (const Token& token : tokenizer.tokenize(text)) words.emplace_back(token.text);
+    vector<string> queries;
+    size_t step = max<size_t>(1, words.size() / 1000);
+    for (size_t i = 0; i < words.size(); i += step) queries.push_back(words[i]);
+    for (const char* miss : {"eqzduw", "zutfjjuc", "tbsiurohqz", "qqqqq", "xyzzy"}) queries.push_back(miss);
+
+    for (bool indexed : {false, true}) {
+        RadixTrie trie(indexed);
+        auto start = Clock::now();
+        for (size_t i = 0; i < words.size(); ++i) trie.insert(words[i], static_cast<int>(i));
+        double build = elapsed_ms(start);
+        size_t hits;
+        double s = time_queries(queries, [&](const string& q) { return trie.search(q).size(); }, hits);
+        cout << "  RadixTrie de paraules" << (indexed ? " + índex hash" : "") << ":\n";
+        cout << "    insert:      " << build << " ms (" << words.size() << " paraules)\n";
+        cout << "    search:      " << s << " ns/consulta (" << hits << " encerts)\n";
+        cout << "    memòria:     " << trie.profile().total_bytes() / 1024 << " KB\n";
+    }
+}
+
+// search()/starts_with() de la interfície Trie sobre les paraules del text,
+// directament i a través del FilteredTrie. Les consultes de make_queries()
+// són subcadenes que sovint travessen paraules, i per tant moltes fallen
+static void bench_filtered(const string& text, const vector<string>& queries) {
+    vector<string> words;
+    Tokenizer tokenizer;
+    for (const Token& token : tokenizer.tokenize(text)) words.emplace_back(token.text);
+
+    NaiveTrie plain;
+    FilteredTrie filtered(make_unique<NaiveTrie>(), 8, words.size());
+    for (const string& word : words) {
+        plain.insert(word);
+        filtered.insert(word);
+    }
+
+    for (const Trie* trie : {static_cast<const Trie*>(&plain), static_cast<const Trie*>(&filtered)}) {
+        size_t hits, prefix_hits;
+        double s = time_queries(queries, [&](const string& q) { return size_t(trie->search(q)); }, hits);
+        double p = time_queries(queries, [&](const string& q) { return size_t(trie->starts_with(q)); }, prefix_hits);
+        cout << "  NaiveTrie de paraules" << (trie == &plain ? "" : " + filtre de Bloom") << ":\n";
+        cout << "    search:      " << s << " ns/consulta (" << hits << " encerts)\n";
+        cout << "    starts_with: " << p << " ns/consulta (" << prefix_hits << " encerts)\n";
+    }
+    cout << "    descartades pel filtre: " << filtered.rejected() << " de "
+         << filtered.rejected() + filtered.forwarded() << " (filtre de "
+         << filtered.filter().memory_bytes() / 1024 << " KB)\n";
+}
+
+// Autocompletat amb un trànsit esbiaixat: el prefix i-èsim dels més comuns
+// (1 a 3 bytes de les paraules del text) surt amb probabilitat ~1/i (Zipf)
+static void bench_cached(const string& text) {
+    vector<string> words;
+    Tokenizer tokenizer;
+    for (const Token& token : tokenizer.tokenize(text)) words.emplace_back(token.text);
+    if (words.empty()) return;
+
+    unordered_map<string, size_t> frequency;
+    for (const string& word : words) {
+        for (size_t len = 1; len <= min<size_t>(3, word.length()); ++len) frequency[word.substr(0, len)]++;
+    }
+    vector<pair<size_t, string>> ranked;
+    for (const auto& entry : frequency) ranked.push_back({entry.second, entry.first});
+    sort(ranked.rbegin(), ranked.rend());
+
+    vector<string> queries;
+    mt19937 rng(42);
+    vector<double> weights;
+    for (size_t i = 0; i < ranked.size(); ++i) weights.push_back(1.0 / (i + 1));
+    discrete_distribution<size_t> zipf(weights.begin(), weights.end());
+    for (int i = 0; i < 20000; ++i) queries.push_back(ranked[zipf(rng)].second);
+
+    NaiveTrie plain;
+    CachedTrie cached(make_unique<NaiveTrie>(), 1024);
+    for (const string& word : words) {
+        plain.insert(word);
+        cached.insert(word);
+    }
+
+    size_t hits;
+    double direct = time_queries(queries, [&](const string& q) {
+        vector<string> found = plain.get_words_with_prefix(q);
+        size_t limit = min<size_t>(10, found.size());
+        partial_sort(found.begin(), found.begin() + limit, found.end());
+        return limit;
+    }, hits);
+    double through = time_queries(queries, [&](const string& q) { return cached.get_words_with_prefix(q, 10).size(); }, hits);
+    cout << "  Autocompletat (10 paraules, " << ranked.size() << " prefixos, " << queries.size() << " consultes):\n";
+    cout << "    NaiveTrie:              " << direct << " ns/consulta\n";
+    cout << "    NaiveTrie + CachedTrie: " << through << " ns/consulta (" << cached.hits() << " encerts de cache, "
+         << cached.misses() << " fallades)\n";
+
+    // Només encerts: la mateixa consulta calenta repetida
+    const string hot = ranked.front().second;
+    vector<string> repeated(queries.size(), hot);
+    double hit = time_queries(repeated, [&](const string& q) { return cached.get_words_with_prefix(q, 10).size(); }, hits);
+    cout << "    encert de cache (\"" << hot << "\"): " << hit << " ns/consulta\n";
+}
+
+// Enumeracions grans: totes les paraules de cada prefix d'una lletra, amb una
+// crida seqüencial i amb AsyncTrie (trossos pel byte següent en paral·lel)
+static void bench_async(const string& text) {
+    vector<string> words;
+    Tokenizer tokenizer;
+    for (const Token& token : tokenizer.tokenize(text)) words.emplace_back(token.text);
+
+    NaiveTrie plain;
+    AsyncTrie async(make_unique<NaiveTrie>());
+    vector<future<void>> inserted;
+    for (const string& word : words) {
+        plain.insert(word);
+        inserted.push_back(async.insert(word));
+    }
+    for (auto& pending : inserted) pending.get();
+
+    vector<string> prefixes;
+    for (char c = 'a'; c <= 'z'; ++c) prefixes.push_back(string(1, c));
+    size_t found = 0;
+    auto start = Clock::now();
+    for (const string& prefix : prefixes) found += plain.get_words_with_prefix(prefix).size();
+    double serial = elapsed_ms(start);
+
+    start = Clock::now();
+    vector<future<vector<string>>> results;
+    for (const string& prefix : prefixes) results.push_back(async.get_words_with_prefix(prefix));
+    size_t async_found = 0;
+    for (auto& result : results) async_found += result.get().size();
+    double parallel = elapsed_ms(start);
+
+    cout << "  Enumeració de 26 prefixos d'una lletra (" << found << " paraules):\n";
+    cout << "    NaiveTrie:            " << serial << " ms\n";
+    cout << "    AsyncTrie (" << ThreadPool::shared().size() << " fils): " << parallel << " ms ("
+         << async_found << " paraules)\n";
+}
+
+// Exportació sencera (get_words()) d'un trie de paraules amb l'enumeració
+// paral·lela i sense
+static void bench_export(const string& text) {
+    RadixTrie radix;
+    NaiveTrie naive;
+    Tokenizer tokenizer;
+    string term;
+    for (const Token& token : tokenizer.tokenize(text)) {
+        term.assign(token.text);
+        radix.insert(term, static_cast<int>(token.offset));
+        naive.insert(term, static_cast<int>(token.offset));
+    }
+
+    cout << "  Exportació amb get_words() (" << ThreadPool::shared().size() << " fils al pool):\n";
+    for (bool parallel : {false, true}) {
+        radix.set_parallel_enumeration(parallel);
+        naive.set_parallel_enumeration(parallel);
+        auto start = Clock::now();
+        size_t exported = radix.get_words().size();
+        double radix_ms = elapsed_ms(start);
+        start = Clock::now();
+        naive.get_words();
+        double naive_ms = elapsed_ms(start);
+        cout << "    " << (parallel ? "paral·lel: " : "seqüencial:") << " RadixTrie " << radix_ms << " ms, NaiveTrie "
+             << naive_ms << " ms (" << exported << " resultats)\n";
+    }
+}
+
+// Prefix més llarg: les entrades són dues paraules seguides sense separador
+// (com un tokenitzador voraç); es compara amb provar search() a cada longitud
+static void bench_longest_prefix(const string& text) {
+    vector<string> words;
+    Tokenizer tokenizer;
+    for (const Token& token : tokenizer.tokenize(text)) words.emplace_back(token.text);
+    if (words.size() < 2) return;
+    vector<string> inputs;
+    size_t step = max<size_t>(1, words.size() / 1000);
+    for (size_t i = 0; i + 1 < words.size(); i += step) inputs.push_back(words[i] + words[i + 1]);
+
+    RadixTrie radix;
+    NaiveTrie naive;
+    PatriciaTrie patricia;
+    IntLpmTable table;
+    for (size_t i = 0; i < words.size(); ++i) {
+        int pos = static_cast<int>(i);
+        radix.insert(words[i], pos);
+        naive.insert(words[i], pos);
+        patricia.insert(words[i], pos);
+        table.insert(IntLpmTable::key_of(words[i]), static_cast<unsigned>(8 * min<size_t>(8, words[i].length())), pos);
+    }
+
+    size_t hits;
+    auto line = [&](const string& name, double ns) {
+        cout << "    " << name << ": " << ns << " ns/consulta (" << hits << " encerts)\n";
+    };
+    cout << "  Prefix més llarg (" << words.size() << " paraules, " << inputs.size() << " entrades):\n";
+    line("RadixTrie, search() per longitud", time_queries(inputs, [&](const string& in) {
+        for (size_t len = in.length(); len > 0; --len) {
+            if (!radix.search(in.substr(0, len)).empty()) return len;
+        }
+        return size_t(0);
+    }, hits));
+    line("RadixTrie   ", time_queries(inputs, [&](const string& in) { return radix.longest_prefix_match(in).length; }, hits));
+    line("NaiveTrie   ", time_queries(inputs, [&](const string& in) { return naive.longest_prefix_match(in).length; }, hits));
+    line("PatriciaTrie", time_queries(inputs, [&](const string& in) { return patricia.longest_prefix_match(in).length; }, hits));
+    line("IntLpmTable (8 bytes)", time_queries(inputs, [&](const string& in) {
+        int value;
+        unsigned bits = 0;
+        return table.longest_prefix_match(IntLpmTable::key_of(in), value, &bits) ? size_t(bits / 8) : size_t(0);
+    }, hits));
+    cout << "    IntLpmTable: " << table.node_count() << " nodes (" << table.memory_bytes() / 1024 << " KB)\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << "Ús: " << argv[0] << " <fitxer> [-n max_caracters] [-b backends] [-s]" << endl;
+        return 1;
+    }
+
+    string filename = argv[1];
+    size_t max_chars = 1000;
+    string backends = "npr";
+    bool dump_stats = false;
+    for (int i = 2; i < argc; ++i) {
+        string flag = argv[i];
+        if (flag == "-n" && i + 1 < argc) max_chars = strtoul(argv[++i], nullptr, 10);
+        else if (flag == "-b" && i + 1 < argc) backends = argv[++i];
+        else if (flag == "-s") dump_stats = true;
+    }
+
+    string text;
+    if (!read_file(filename, text)) return 1;
+    if (text.length() > max_chars) text.resize(max_chars);
+
+    vector<string> queries = make_queries(text);
+    cout << "=== Benchmark de sufixos: " << filename << " (" << text.length()
+         << " caràcters, " << queries.size() << " consultes) ===" << endl;
+
+    size_t hits, prefix_hits;
+
+    if (backends.find('n') != string::npos) {
+        NaiveTrie trie;
+        auto start = Clock::now();
+        trie.init(text);
+        double build = elapsed_ms(start);
+        double s = time_queries(queries, [&](const string& q) { return trie.search_positions(q).size(); }, hits);
+        double p = time_queries(queries, [&](const string& q) { return trie.starts_with_positions(q).size(); }, prefix_hits);
+        report("NaiveTrie", build, s, p, hits);
+        if (dump_stats) cout << "    stats: " << trie.stats().to_json() << "\n";
+    }
+
+    if (backends.find('p') != string::npos) {
+        PatriciaTrie trie;
+        auto start = Clock::now();
+        trie.init(text);
+        double build = elapsed_ms(start);
+        double s = time_queries(queries, [&](const string& q) { return trie.search_positions(q).size(); }, hits);
+        double p = time_queries(queries, [&](const string& q) { return trie.starts_with_positions(q).size(); }, prefix_hits);
+        report("PatriciaTrie", build, s, p, hits);
+        if (dump_stats) cout << "    stats: " << trie.stats().to_json() << "\n";
+    }
+
+    if (backends.find('r') != string::npos) {
+        RadixTrie trie;
+        auto start = Clock::now();
+        trie.init(text);
+        double build = elapsed_ms(start);
+        double s = time_queries(queries, [&](const string& q) { return trie.search(q).size(); }, hits);
+        double p = time_queries(queries, [&](const string& q) { return trie.starts_with(q).size(); }, prefix_hits);
+        report("RadixTrie", build, s, p, hits);
+        double c = time_queries(queries, [&](const string& q) { return trie.count_positions(q); }, prefix_hits);
+        cout << "    count_positions: " << c << " ns/consulta (sense materialitzar starts_with)\n";
+
+        // Analítiques de subcadenes: un recorregut de l'índex cadascuna
+        start = Clock::now();
+        string repeat = trie.longest_repeated_substring();
+        cout << "    repetida més llarga: " << repeat.length() << " bytes (" << elapsed_ms(start) << " ms)\n";
+        start = Clock::now();
+        auto frequent = trie.most_frequent_substrings(10, 4);
+        cout << "    10 més freqüents (>= 4 bytes): " << elapsed_ms(start) << " ms";
+        if (!frequent.empty()) cout << ", la primera " << frequent[0].second << " cops";
+        cout << "\n";
+        size_t half = text.length() / 2;
+        start = Clock::now();
+        string common = RadixTrie::longest_common_substring(text.substr(0, half), text.substr(half));
+        cout << "    comuna més llarga entre meitats: " << common.length() << " bytes (" << elapsed_ms(start)
+             << " ms)\n";
+        if (dump_stats) cout << "    stats: " << trie.stats().to_json() << "\n";
+
+        // append(): el darrer 10% del text sobre un índex del 90% anterior
+        RadixTrie grown;
+        size_t split = text.length() - text.length() / 10;
+        grown.init(text.substr(0, split));
+        start = Clock::now();
+        grown.append(text.substr(split));
+        cout << "    append 10%:  " << elapsed_ms(start) << " ms\n";
+    }
+
+    if (backends.find('c') != string::npos) {
+        RadixTrie source;
+        source.init(text);
+        for (auto layout : {CompactRadixTrie::Layout::BreadthFirst, CompactRadixTrie::Layout::Preorder,
+                            CompactRadixTrie::Layout::VanEmdeBoas}) {
+            auto start = Clock::now();
+            CompactRadixTrie trie(source, layout);
+            double build = elapsed_ms(start);
+            double s = time_queries(queries, [&](const string& q) { return trie.search(q).size(); }, hits);
+            double p = time_queries(queries, [&](const string& q) { return trie.starts_with(q).size(); }, prefix_hits);
+            report(string("CompactRadixTrie (") + CompactRadixTrie::layout_name(layout) + ")", build, s, p, hits);
+        }
+    }
+
+    if (backends.find('h') != string::npos) bench_exact_index(text);
+    if (backends.find('f') != string::npos) bench_filtered(text, queries);
+    if (backends.find('l') != string::npos) bench_longest_prefix(text);
+    if (backends.find('k') != string::npos) bench_cached(text);
+    if (backends.find('y') != string::npos) bench_async(text);
+    if (backends.find('e') != string::npos) bench_export(text);
+
+    if (backends.find('1') != string::npos) bench_bit_radix<1>(text, queries);
+    if (backends.find('2') != string::npos) bench_bit_radix<2>(text, queries);
+    if (backends.find('4') != string::npos) bench_bit_radix<4>(text, queries);
+    if (backends.find('8') != string::npos) bench_bit_radix<8>(text, queries);
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include "../include/docIndex.h"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Cerca sobre un índex invertit de diversos documents.
+//
+// Ús: docsearch <fitxer|directori>... [-t terme]... [-p frase]... [-n a b k]...
+//                 [-d document] [-m max_resultats]
+//   -t: terme a cercar (es pot repetir)
+//   -p: frase a cercar, entre cometes (es pot repetir)
+//   -n: ocurrències de a amb b a com a molt k paraules (es pot repetir)
+//   -d: només el document amb aquest nom (tal com apareix al llistat)
+//   -m: ocurrències a mostrar per consulta (per defecte 10)
+
+using Clock = chrono::steady_clock;
+
+static double elapsed_us(Clock::time_point start) {
+    return chrono::duration<double, micro>(Clock::now() - start).count();
+}
+
+static void print_postings(const DocumentIndex& index, const vector<DocumentIndex::Posting>& postings,
+                           size_t max_results) {
+    for (size_t i = 0; i < postings.size() && i < max_results; ++i) {
+        const auto& p = postings[i];
+        cout << "    " << index.document_name(p.doc) << "  línia " << p.line + 1
+             << ", paràgraf " << p.paragraph + 1 << ", paraula " << p.word << "\n";
+    }
+    if (postings.size() > max_results) {
+        cout << "    ... (" << postings.size() - max_results << " més)\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << "Ús: " << argv[0] << " <fitxer|directori>... [-t terme]... [-p frase]... [-n a b k]..."
+             << " [-d document] [-m max_resultats]" << endl;
+        return 1;
+    }
+
+    vector<string> paths, terms, phrases;
+    vector<pair<pair<string, string>, uint32_t>> near_queries;
+    string document;
+    size_t max_results = 10;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-t" && i + 1 < argc) terms.push_back(argv[++i]);
+        else if (arg == "-p" && i + 1 < argc) phrases.push_back(argv[++i]);
+        else if (arg == "-n" && i + 3 < argc) {
+            near_queries.push_back({{argv[i + 1], argv[i + 2]}, static_cast<uint32_t>(strtoul(argv[i + 3], nullptr, 10))});
+            i += 3;
+        }
+        else if (arg == "-d" && i + 1 < argc) document = argv[++i];
+        else if (arg == "-m" && i + 1 < argc) max_results = strtoul(argv[++i], nullptr, 10);
+        else paths.push_back(arg);
+    }
+
+    DocumentIndex index;
+    auto start = Clock::now();
+    for (const string& path : paths) {
+        bool ok = filesystem::is_directory(path) ? index.add_directory(path) > 0 : index.add_file(path);
+        if (!ok) cout << "Error: No s'ha pogut indexar " << path << endl;
+    }
+    double build = elapsed_us(start) / 1000.0;
+
+    cout << "=== Índex: " << index.document_count() << " documents, " << index.term_count()
+         << " termes, " << index.posting_count() << " ocurrències (" << build << " ms, "
+         << index.postings_bytes() / 1024 << " KB d'ocurrències) ===" << endl;
+    for (size_t d = 0; d < index.document_count(); ++d) {
+        cout << "  [" << d << "] " << index.document_name(d) << " (" << index.document_words(d) << " paraules)\n";
+    }
+
+    int doc = -1;  // -1 = tots els documents
+    if (!document.empty()) {
+        doc = index.find_document(document);
+        if (doc < 0) {
+            cout << "Error: document desconegut " << document << endl;
+            return 1;
+        }
+    }
+
+    for (const string& term : terms) {
+        start = Clock::now();
+        auto postings = doc < 0 ? index.lookup(term) : index.lookup(term, doc);
+        double us = elapsed_us(start);
+        cout << "\n'" << term << "': " << postings.size() << " ocurrències (" << us << " us)\n";
+        print_postings(index, postings, max_results);
+    }
+
+    uint32_t scope = doc < 0 ? DocumentIndex::all_documents : doc;
+    for (const string& phrase : phrases) {
+        start = Clock::now();
+        auto postings = index.phrase_search(phrase, scope);
+        double us = elapsed_us(start);
+        cout << "\n\"" << phrase << "\": " << postings.size() << " ocurrències (" << us << " us)\n";
+        print_postings(index, postings, max_results);
+    }
+
+    for (const auto& query : near_queries) {
+        const string& a = query.first.first;
+        const string& b = query.first.second;
+        start = Clock::now();
+        auto matches = index.near(a, b, query.second, scope);
+        double us = elapsed_us(start);
+        cout << "\n'" << a << "' a prop de '" << b << "' (k=" << query.second << "): "
+             << matches.size() << " ocurrències (" << us << " us)\n";
+        vector<DocumentIndex::Posting> postings;
+        for (const auto& match : matches) postings.push_back(match.first);
+        print_postings(index, postings, max_results);
+    }
+
+    return 0;
+}
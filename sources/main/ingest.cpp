@@ -0,0 +1,164 @@
+#include "../include/ingest.h"
+#include "../include/tokenizer.h"
+#include "../include/naive.h"
+#include "../include/patricia.h"
+#include "../include/radixDone.h"
+#include "../include/bitRadix.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Ingesta en pipeline: llegeix diversos fitxers amb IngestPipeline (lector ->
+// tokenitzador -> inseridors) i n'imprimeix el throughput i les esperes de
+// cada etapa.
+//
+// Ús: ingest <fitxer>... [-b backend] [-i inseridors] [-l carrils] [-c kb] [-t termes] [-s] [-k]
+//   backend: 'n' (NaiveTrie), 'l' (LowercaseNaiveTrie), 'p' (PatriciaTrie),
+//            'r' (RadixTrie, per defecte) o '1', '2', '4', '8' (BitRadixTrie)
+//   -i: inseridors, cadascun amb el seu trie (shard pel primer byte del terme)
+//   -l: carrils lector + tokenitzador (els fitxers s'hi reparteixen)
+//   -c: mida dels blocs de lectura en KB
+//   -t: termes per lot cap als inseridors
+//   -s: fa també la ingesta seqüencial (un sol bucle i un sol trie) per comparar
+//   -k: compara el throughput del Tokenizer amb cada ISA (escalar, SSE2, AVX2)
+
+using Clock = chrono::steady_clock;
+
+static bool read_file(const string& filename, string& text) {
+    ifstream file(filename, ios::binary);
+    if (!file.is_open()) return false;
+    ostringstream buffer;
+    buffer << file.rdbuf();
+    text = buffer.str();
+    return true;
+}
+
+// Ingesta seqüencial de referència: mateixos termes i posicions que el pipeline
+template <class TrieType>
+static size_t ingest_sequential(TrieType& trie, const vector<string>& files) {
+    Tokenizer tokenizer;
+    size_t tokens = 0;
+    size_t base = 0;
+    string text, term;
+    for (const string& filename : files) {
+        if (!read_file(filename, text)) continue;
+        if (text.length() > IngestPipeline<TrieType>::MaxBytes - base) continue;  // Com el pipeline
+        for (const Token& token : tokenizer.tokenize(text, base)) {
+            term.assign(token.text);
+            trie.insert(term, static_cast<int>(token.offset));
+            tokens++;
+        }
+        base += text.length();
+    }
+    return tokens;
+}
+
+// Throughput del Tokenizer amb cada ISA suportada sobre els fitxers
+static void compare_tokenizers(const vector<string>& files) {
+    vector<string> texts(files.size());
+    size_t bytes = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (read_file(files[i], texts[i])) bytes += texts[i].length();
+    }
+
+    cout << "Tokenitzador (" << bytes / (1024.0 * 1024.0) << " MB):\n";
+    for (auto isa : {Tokenizer::Isa::Scalar, Tokenizer::Isa::SSE2, Tokenizer::Isa::AVX2}) {
+        if (!Tokenizer::supported(isa)) continue;
+        Tokenizer tokenizer(isa);
+        size_t tokens = 0;
+        auto start = Clock::now();
+        for (const string& text : texts) tokens += tokenizer.tokenize(text).size();
+        double ms = chrono::duration<double, milli>(Clock::now() - start).count();
+        cout << "  " << Tokenizer::isa_name(isa) << ": " << tokens << " termes en " << ms << " ms ("
+             << (ms > 0 ? bytes / (1024.0 * 1024.0) / (ms / 1000.0) : 0.0) << " MB/s)\n";
+    }
+}
+
+template <class TrieType>
+static void run(const vector<string>& files, size_t inserters,
+                const IngestOptions& options, bool sequential) {
+    vector<unique_ptr<TrieType>> shards;
+    vector<TrieType*> targets;
+    for (size_t s = 0; s < inserters; ++s) {
+        shards.push_back(make_unique<TrieType>());
+        targets.push_back(shards.back().get());
+    }
+
+    IngestPipeline<TrieType> pipeline(targets, options);
+    IngestStats stats = pipeline.run(files);
+    cout << "Pipeline (" << options.lanes << " carrils, " << inserters << " inseridors):\n" << stats.to_string();
+
+    size_t keys = 0;
+    for (const auto& shard : shards) keys += shard->get_words().size();
+    cout << "  parells (terme, posició) als tries: " << keys << "\n";
+
+    if (sequential) {
+        TrieType trie;
+        auto start = Clock::now();
+        size_t tokens = ingest_sequential(trie, files);
+        double ms = chrono::duration<double, milli>(Clock::now() - start).count();
+        cout << "Seqüencial: " << tokens << " termes en " << ms << " ms (x"
+             << (stats.wall_ms > 0 ? ms / stats.wall_ms : 0.0) << " més lent que el pipeline)\n";
+        cout << "  parells (terme, posició) al trie: " << trie.get_words().size() << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << "Ús: " << argv[0] << " <fitxer>... [-b backend] [-i inseridors] [-l carrils] [-c kb] [-t termes] [-s] [-k]"
+             << endl;
+        return 1;
+    }
+
+    vector<string> files;
+    char backend = 'r';
+    size_t inserters = 2;
+    size_t lanes = 1;
+    size_t chunk_kb = 64;
+    size_t batch_tokens = 512;
+    bool sequential = false;
+    bool tokenizers = false;
+    for (int i = 1; i < argc; ++i) {
+        string flag = argv[i];
+        if (flag == "-b" && i + 1 < argc) backend = argv[++i][0];
+        else if (flag == "-i" && i + 1 < argc) inserters = strtoul(argv[++i], nullptr, 10);
+        else if (flag == "-l" && i + 1 < argc) lanes = strtoul(argv[++i], nullptr, 10);
+        else if (flag == "-c" && i + 1 < argc) chunk_kb = strtoul(argv[++i], nullptr, 10);
+        else if (flag == "-t" && i + 1 < argc) batch_tokens = strtoul(argv[++i], nullptr, 10);
+        else if (flag == "-s") sequential = true;
+        else if (flag == "-k") tokenizers = true;
+        else files.push_back(flag);
+    }
+    if (files.empty() || inserters == 0) {
+        cout << "Error: cal almenys un fitxer i un inseridor" << endl;
+        return 1;
+    }
+
+    if (tokenizers) compare_tokenizers(files);
+
+    IngestOptions options;
+    options.lanes = lanes;
+    options.chunk_bytes = chunk_kb * 1024;
+    options.batch_tokens = batch_tokens;
+
+    switch (backend) {
+        case 'n': run<NaiveTrie>(files, inserters, options, sequential); break;
+        case 'l': run<LowercaseNaiveTrie>(files, inserters, options, sequential); break;
+        case 'p': run<PatriciaTrie>(files, inserters, options, sequential); break;
+        case 'r': run<RadixTrie>(files, inserters, options, sequential); break;
+        case '1': run<BitRadixTrie<1>>(files, inserters, options, sequential); break;
+        case '2': run<BitRadixTrie<2>>(files, inserters, options, sequential); break;
+        case '4': run<BitRadixTrie<4>>(files, inserters, options, sequential); break;
+        case '8': run<BitRadixTrie<8>>(files, inserters, options, sequential); break;
+        default:
+            cout << "Error: backend desconegut '" << backend << "'" << endl;
+            return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include "../include/stats.h"
+#include "../include/tokenizer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+using namespace std;
+
+// Generador de càrrega per al servidor de consultes (bin/server): obre
+// diverses connexions, cadascuna en un fil, i hi envia peticions amb
+// diverses peticions en vol per connexió. Mesura el throughput i els
+// percentils de latència (des que s'envia una petició fins que arriba la
+// seva resposta).
+//
+// Ús: loadgen <fitxer> [-s socket] [-c connexions] [-r peticions] [-d profunditat]
+//   fitxer: d'on surten les consultes (els termes del Tokenizer)
+//   -c: connexions concurrents (un fil cadascuna)
+//   -r: peticions per connexió
+//   -d: peticions en vol per connexió (1 = esperar cada resposta)
+//
+// Les consultes barregen les quatre operacions del protocol: autocompletat de
+// 10 paraules amb prefixos d'1 a 3 bytes, search i count d'un terme i prefix
+// més llarg de dos termes seguits.
+
+using Clock = chrono::steady_clock;
+
+static bool read_file(const string& filename, string& text) {
+    ifstream file(filename, ios::binary);
+    if (!file.is_open()) return false;
+    ostringstream buffer;
+    buffer << file.rdbuf();
+    text = buffer.str();
+    return true;
+}
+
+static vector<string> make_requests(const vector<string>& terms, size_t count, unsigned seed) {
+    vector<string> requests;
+    mt19937 rng(seed);
+    uniform_int_distribution<size_t> pick(0, terms.size() - 1);
+    for (size_t i = 0; i < count; ++i) {
+        const string& term = terms[pick(rng)];
+        switch (i % 4) {
+            case 0: requests.push_back("A 10 " + term.substr(0, 1 + rng() % 3)); break;
+            case 1: requests.push_back("S " + term); break;
+            case 2: requests.push_back("C " + term); break;
+            default: requests.push_back("L " + term + terms[pick(rng)]); break;
+        }
+    }
+    return requests;
+}
+
+// Una connexió: manté 'depth' peticions en vol i apunta la latència de cada
+// resposta (les respostes arriben en ordre)
+static bool run_connection(const string& socket_path, const vector<string>& requests, size_t depth,
+                           vector<uint64_t>& latencies) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        if (fd >= 0) close(fd);
+        return false;
+    }
+
+    deque<Clock::time_point> in_flight;
+    size_t sent = 0, received = 0;
+    string input, output;
+    char buffer[16384];
+    while (received < requests.size()) {
+        // Omple la finestra de peticions en vol i les envia de cop
+        output.clear();
+        while (sent < requests.size() && in_flight.size() < depth) {
+            output += requests[sent++];
+            output += '\n';
+            in_flight.push_back(Clock::now());
+        }
+        for (size_t written = 0; written < output.length();) {
+            ssize_t n = send(fd, output.data() + written, output.length() - written, MSG_NOSIGNAL);
+            if (n <= 0) {
+                close(fd);
+                return false;
+            }
+            written += static_cast<size_t>(n);
+        }
+
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            close(fd);
+            return false;
+        }
+        input.append(buffer, static_cast<size_t>(n));
+        size_t start = 0;
+        for (size_t end; (end = input.find('\n', start)) != string::npos; start = end + 1) {
+            auto now = Clock::now();
+            latencies.push_back(chrono::duration_cast<chrono::nanoseconds>(now - in_flight.front()).count());
+            in_flight.pop_front();
+            received++;
+        }
+        input.erase(0, start);
+    }
+    close(fd);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << "Ús: " << argv[0] << " <fitxer> [-s socket] [-c connexions] [-r peticions] [-d profunditat]" << endl;
+        return 1;
+    }
+
+    string filename = argv[1];
+    string socket_path = "/tmp/trie.sock";
+    size_t connections = 4;
+    size_t per_connection = 20000;
+    size_t depth = 8;
+    for (int i = 2; i < argc; ++i) {
+        string flag = argv[i];
+        if (flag == "-s" && i + 1 < argc) socket_path = argv[++i];
+        else if (flag == "-c" && i + 1 < argc) connections = max<size_t>(1, strtoull(argv[++i], nullptr, 10));
+        else if (flag == "-r" && i + 1 < argc) per_connection = strtoull(argv[++i], nullptr, 10);
+        else if (flag == "-d" && i + 1 < argc) depth = max<size_t>(1, strtoull(argv[++i], nullptr, 10));
+    }
+
+    string text;
+    if (!read_file(filename, text)) {
+        cout << "Error: No s'ha pogut obrir el fitxer " << filename << endl;
+        return 1;
+    }
+    vector<string> terms;
+    Tokenizer tokenizer;
+    for (const Token& token : tokenizer.tokenize(text)) terms.emplace_back(token.text);
+    if (terms.empty()) {
+        cout << "Error: el fitxer no té cap terme" << endl;
+        return 1;
+    }
+
+    vector<vector<string>> requests;
+    for (size_t c = 0; c < connections; ++c) {
+        requests.push_back(make_requests(terms, per_connection, static_cast<unsigned>(c + 1)));
+    }
+    vector<vector<uint64_t>> latencies(connections);
+    vector<char> ok(connections, 0);
+    vector<thread> threads;
+
+    auto start = Clock::now();
+    for (size_t c = 0; c < connections; ++c) {
+        threads.emplace_back([&, c] { ok[c] = run_connection(socket_path, requests[c], depth, latencies[c]); });
+    }
+    for (thread& t : threads) t.join();
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+
+    LatencyHistogram histogram;
+    size_t completed = 0;
+    for (size_t c = 0; c < connections; ++c) {
+        if (!ok[c]) cout << "Avís: la connexió " << c << " ha fallat" << endl;
+        for (uint64_t ns : latencies[c]) histogram.record(ns);
+        completed += latencies[c].size();
+    }
+
+    cout << "=== Càrrega sobre " << socket_path << ": " << connections << " connexions, " << depth
+         << " peticions en vol cadascuna ===" << endl;
+    cout << "  respostes:  " << completed << " en " << seconds * 1000 << " ms" << endl;
+    cout << "  throughput: " << (seconds > 0 ? completed / seconds : 0.0) << " peticions/s" << endl;
+    cout << "  latència:   p50 " << histogram.percentile(50) / 1000.0 << " us, p90 "
+         << histogram.percentile(90) / 1000.0 << " us, p99 " << histogram.percentile(99) / 1000.0 << " us, p99.9 "
+         << histogram.percentile(99.9) / 1000.0 << " us, màxim " << histogram.max() / 1000.0 << " us" << endl;
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include "../include/naive.h"
+#include "../include/patricia.h"
+#include "../include/radixDone.h"
+#include "../include/compactRadix.h"
+#include "../include/bitRadix.h"
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Perfil de memòria i forma: construeix cada backend sobre un fitxer i
+// n'imprimeix el desglossament de bytes i els histogrames de profile().
+//
+// Ús: profile <fitxer> [-m words|suffixes] [-n max] [-b backends] [-j]
+//   -m words:    insereix cada paraula (separada per espais) amb la seva posició
+//   -m suffixes: init() amb els primers max caràcters (índex de sufixos)
+//   -n: màxim de paraules (words) o de caràcters (suffixes)
+//   backends: 'n' (NaiveTrie), 'l' (LowercaseNaiveTrie), 'p' (PatriciaTrie),
+//             'r' (RadixTrie), 'c' (CompactRadixTrie, layout van Emde Boas)
+//             i '1', '2', '4', '8' (BitRadixTrie)
+//   -j: una línia JSON per backend en lloc de l'informe de consola
+
+static bool read_file(const string& filename, string& text) {
+    ifstream file(filename, ios::binary);
+    if (!file.is_open()) {
+        cout << "Error: No s'ha pogut obrir el fitxer " << filename << endl;
+        return false;
+    }
+    ostringstream buffer;
+    buffer << file.rdbuf();
+    text = buffer.str();
+    return true;
+}
+
+// Separa el text en paraules i en guarda la posició d'inici
+static vector<pair<string, int>> split_words(const string& text, size_t max_words) {
+    vector<pair<string, int>> words;
+    size_t i = 0;
+    while (i < text.length() && words.size() < max_words) {
+        while (i < text.length() && isspace(static_cast<unsigned char>(text[i]))) ++i;
+        size_t start = i;
+        while (i < text.length() && !isspace(static_cast<unsigned char>(text[i]))) ++i;
+        if (i > start) words.push_back({text.substr(start, i - start), static_cast<int>(start)});
+    }
+    return words;
+}
+
+// Omple un backend amb el mode triat
+template <class TrieType>
+static void build(TrieType& trie, const string& text, const vector<pair<string, int>>& words, bool suffixes) {
+    if (suffixes) {
+        trie.init(text);
+    } else {
+        for (const auto& word : words) trie.insert(word.first, word.second);
+    }
+}
+
+static void print_profile(const TrieProfile& report, bool json) {
+    if (json) cout << report.to_json() << "\n";
+    else cout << report.to_string() << "\n";
+}
+
+// Construeix un backend amb el mode triat i n'imprimeix el perfil
+template <class TrieType>
+static void profile_backend(const string& text, const vector<pair<string, int>>& words,
+                            bool suffixes, bool json) {
+    TrieType trie;
+    build(trie, text, words, suffixes);
+    print_profile(trie.profile(), json);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << "Ús: " << argv[0] << " <fitxer> [-m words|suffixes] [-n max] [-b backends] [-j]" << endl;
+        return 1;
+    }
+
+    string filename = argv[1];
+    string mode = "words";
+    size_t max_items = 0;
+    string backends = "lpr";
+    bool json = false;
+    for (int i = 2; i < argc; ++i) {
+        string flag = argv[i];
+        if (flag == "-m" && i + 1 < argc) mode = argv[++i];
+        else if (flag == "-n" && i + 1 < argc) max_items = strtoul(argv[++i], nullptr, 10);
+        else if (flag == "-b" && i + 1 < argc) backends = argv[++i];
+        else if (flag == "-j") json = true;
+    }
+    if (mode != "words" && mode != "suffixes") {
+        cout << "Error: mode desconegut '" << mode << "' (words o suffixes)" << endl;
+        return 1;
+    }
+
+    string text;
+    if (!read_file(filename, text)) return 1;
+
+    bool suffixes = mode == "suffixes";
+    vector<pair<string, int>> words;
+    if (suffixes) {
+        // Sense límit explícit, un índex de sufixos de tot el fitxer no hi cap
+        if (max_items == 0) max_items = 1000;
+        if (text.length() > max_items) text.resize(max_items);
+    } else {
+        words = split_words(text, max_items ? max_items : text.length());
+    }
+
+    if (!json) {
+        cout << "=== Perfil de memòria: " << filename << " (" << mode << ", "
+             << (suffixes ? text.length() : words.size())
+             << (suffixes ? " caràcters" : " paraules") << ") ===" << endl;
+    }
+
+    if (backends.find('n') != string::npos) profile_backend<NaiveTrie>(text, words, suffixes, json);
+    if (backends.find('l') != string::npos) profile_backend<LowercaseNaiveTrie>(text, words, suffixes, json);
+    if (backends.find('p') != string::npos) profile_backend<PatriciaTrie>(text, words, suffixes, json);
+    if (backends.find('r') != string::npos) profile_backend<RadixTrie>(text, words, suffixes, json);
+    if (backends.find('c') != string::npos) {
+        RadixTrie source;
+        build(source, text, words, suffixes);
+        print_profile(CompactRadixTrie(source).profile(), json);
+    }
+    if (backends.find('1') != string::npos) profile_backend<BitRadixTrie<1>>(text, words, suffixes, json);
+    if (backends.find('2') != string::npos) profile_backend<BitRadixTrie<2>>(text, words, suffixes, json);
+    if (backends.find('4') != string::npos) profile_backend<BitRadixTrie<4>>(text, words, suffixes, json);
+    if (backends.find('8') != string::npos) profile_backend<BitRadixTrie<8>>(text, words, suffixes, json);
+
+    return 0;
+}
@@ -0,0 +1,483 @@
+#include "../include/queryProtocol.h"
+#include "../include/radixDone.h"
+#include "../include/tokenizer.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// Servidor de consultes: construeix un RadixTrie una sola vegada a partir
+// d'un fitxer (mapat amb mmap) i el serveix per un socket Unix.
+//
+// Ús: server <fitxer> [-m words|suffixes] [-n max] [-s socket] [-w workers] [-g gra]
+//   -m words:    cada terme del Tokenizer amb la seva posició (per defecte)
+//   -m suffixes: init() amb els primers max caràcters (índex de sufixos)
+//   -n: bytes del fitxer que s'indexen (les posicions són int: com a molt 2 GiB)
+//   -s: camí del socket (per defecte /tmp/trie.sock)
+//   -w: fils treballadors a més del bucle d'esdeveniments (per defecte nuclis - 1)
+//   -g: peticions que agafa cada fil de cop dins d'un lot
+//
+// Protocol de línies: una petició per línia i una resposta per línia, en el
+// mateix ordre dins de cada connexió (es poden enviar peticions sense esperar
+// les respostes). L'argument és la resta de la línia i pot tenir espais. Les
+// operacions (S, C, A, L) són a queryProtocol.h; amb -m suffixes no hi ha A.
+//
+// Un sol fil fa el bucle epoll: llegeix de totes les connexions que en tenen
+// i ajunta totes les línies completes en un lot, que es reparteix entre els
+// treballadors. Mentre el lot s'executa no es llegeix res: les peticions que
+// arriben mentrestant formen el lot següent, de manera que com més càrrega,
+// més grans són els lots. Les consultes són de només lectura i no es
+// bloquegen entre elles (compileu sense STATS=1: els comptadors no són
+// thread-safe). Una connexió amb més de OutputHighWater bytes de respostes
+// per escriure deixa de llegir-se fins que el client se les emporta; de cada
+// connexió s'agafen com a molt MaxRequestsPerBatch peticions per lot (la resta
+// espera al buffer d'entrada), i una línia de més de MaxLineLength bytes es
+// respon amb ERR i tanca la connexió.
+
+using Clock = chrono::steady_clock;
+
+// Les posicions del RadixTrie són int: de 0 a INT_MAX
+static const size_t MaxIndexBytes = size_t(INT_MAX) + 1;
+static const size_t OutputHighWater = 1 << 20;
+static const size_t MaxLineLength = 64 * 1024;
+static const size_t MaxRequestsPerBatch = 1024;
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void on_signal(int) {
+    stop_requested = 1;
+}
+
+struct Request {
+    int fd;
+    string line;
+    string response;
+};
+
+struct Connection {
+    string input;   // bytes rebuts sense línia completa
+    string output;  // respostes pendents d'escriure
+    bool closing = false;          // l'altre costat ja no enviarà res més
+    bool backlog = false;          // té línies completes que no han cabut al lot
+    bool too_long = false;         // ha enviat una línia de més de MaxLineLength bytes
+    uint32_t registered = EPOLLIN; // esdeveniments demanats a epoll
+
+    // Se li poden agafar peticions: si no, les respostes s'acumularien
+    bool accepts_requests() const { return output.length() < OutputHighWater; }
+
+    // Es llegeix mentre l'altre costat pot enviar i les respostes no s'acumulen
+    uint32_t wanted_events() const {
+        uint32_t events = 0;
+        if (!closing && accepts_requests()) events |= EPOLLIN;
+        if (!output.empty()) events |= EPOLLOUT;
+        return events;
+    }
+};
+
+// Fils que executen un lot de peticions. El fil que crida run() també hi
+// treballa, i un lot que no arriba a dos grans no desperta ningú.
+class BatchPool {
+public:
+    BatchPool(size_t workers, size_t grain, function<void(Request&)> handle)
+        : grain(max<size_t>(1, grain)), handle(std::move(handle)) {
+        for (size_t i = 0; i < workers; ++i) threads.emplace_back([this] { work(); });
+    }
+
+    ~BatchPool() {
+        {
+            lock_guard<mutex> guard(lock);
+            shutting_down = true;
+        }
+        wake.notify_all();
+        for (thread& t : threads) t.join();
+    }
+
+    void run(vector<Request>& batch) {
+        if (threads.empty() || batch.size() < 2 * grain) {
+            for (Request& request : batch) handle(request);
+            return;
+        }
+        {
+            lock_guard<mutex> guard(lock);
+            current = &batch;
+            next = 0;
+            pending = batch.size();
+            generation++;
+        }
+        wake.notify_all();
+        size_t done = process(batch);
+        unique_lock<mutex> guard(lock);
+        pending -= done;
+        // Cap fil no pot continuar mirant el lot quan run() torna
+        finished.wait(guard, [this] { return pending == 0 && active == 0; });
+        current = nullptr;
+    }
+
+private:
+    size_t grain;
+    function<void(Request&)> handle;
+    vector<thread> threads;
+    mutex lock;
+    condition_variable wake;
+    condition_variable finished;
+    vector<Request>* current = nullptr;
+    atomic<size_t> next{0};
+    size_t pending = 0;
+    size_t active = 0;
+    uint64_t generation = 0;
+    bool shutting_down = false;
+
+    size_t process(vector<Request>& batch) {
+        size_t done = 0;
+        for (;;) {
+            size_t begin = next.fetch_add(grain);
+            if (begin >= batch.size()) break;
+            size_t end = min(batch.size(), begin + grain);
+            for (size_t i = begin; i < end; ++i) handle(batch[i]);
+            done += end - begin;
+        }
+        return done;
+    }
+
+    void work() {
+        uint64_t seen = 0;
+        for (;;) {
+            vector<Request>* batch;
+            {
+                unique_lock<mutex> guard(lock);
+                wake.wait(guard, [&] { return shutting_down || (generation != seen && current); });
+                if (shutting_down) return;
+                seen = generation;
+                batch = current;
+                active++;
+            }
+            size_t done = process(*batch);
+            lock_guard<mutex> guard(lock);
+            pending -= done;
+            active--;
+            if (pending == 0 && active == 0) finished.notify_one();
+        }
+    }
+};
+
+// Mapa el fitxer i construeix l'índex directament sobre les pàgines mapades;
+// retorna el missatge d'error o un string buit
+static string load_index(const string& filename, const string& mode, size_t max_chars, RadixTrie& trie) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return "No s'ha pogut obrir el fitxer " + filename;
+    struct stat info;
+    if (fstat(fd, &info) < 0) {
+        close(fd);
+        return "No s'ha pogut obrir el fitxer " + filename;
+    }
+    size_t length = min(static_cast<size_t>(info.st_size), max_chars);
+    if (length > MaxIndexBytes) {
+        close(fd);
+        return "El fitxer passa de " + to_string(MaxIndexBytes) + " bytes i les posicions no caben en un int (feu servir -n)";
+    }
+    const char* data = nullptr;
+    if (info.st_size > 0) {
+        void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            close(fd);
+            return "No s'ha pogut mapar el fitxer " + filename;
+        }
+        data = static_cast<const char*>(mapped);
+    }
+    close(fd);
+
+    if (mode == "suffixes") {
+        trie.init(string(data, length));
+    } else {
+        Tokenizer tokenizer;
+        string term;
+        for (const Token& token : tokenizer.tokenize(data, length)) {
+            term.assign(token.text);
+            trie.insert(term, static_cast<int>(token.offset));
+        }
+    }
+    if (data) munmap(const_cast<char*>(data), static_cast<size_t>(info.st_size));
+    return string();
+}
+
+static bool set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// Escriu tot el que es pugui sense bloquejar; false si la connexió ha fallat
+static bool flush_output(int fd, Connection& connection) {
+    size_t written = 0;
+    while (written < connection.output.length()) {
+        ssize_t n = send(fd, connection.output.data() + written, connection.output.length() - written, MSG_NOSIGNAL);
+        if (n > 0) {
+            written += static_cast<size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            return false;
+        }
+    }
+    connection.output.erase(0, written);
+    return true;
+}
+
+// Llegeix fins a EAGAIN (o fins que l'entrada pendent arriba a MaxLineLength
+// bytes) i passa al lot com a molt MaxRequestsPerBatch línies completes; false
+// si la connexió ha fallat
+static bool read_requests(int fd, Connection& connection, vector<Request>& batch) {
+    char buffer[16384];
+    while (!connection.closing && connection.input.length() < MaxLineLength) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            connection.input.append(buffer, static_cast<size_t>(n));
+        } else if (n == 0) {
+            connection.closing = true;
+            break;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else {
+            return false;
+        }
+    }
+
+    vector<string> lines;
+    connection.backlog = take_lines(connection.input, MaxRequestsPerBatch, lines);
+    for (string& line : lines) batch.push_back({fd, std::move(line), string()});
+
+    // Una línia que no acaba abans del límit no es llegeix sencera mai
+    if (!connection.backlog && connection.input.length() >= MaxLineLength) {
+        connection.input.clear();
+        connection.too_long = true;
+        connection.closing = true;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << "Ús: " << argv[0] << " <fitxer> [-m words|suffixes] [-n max] [-s socket] [-w workers] [-g gra]" << endl;
+        return 1;
+    }
+
+    string filename = argv[1];
+    string mode = "words";
+    string socket_path = "/tmp/trie.sock";
+    size_t max_chars = string::npos;
+    unsigned cores = thread::hardware_concurrency();
+    size_t workers = cores > 1 ? cores - 1 : 0;
+    size_t grain = 16;
+    for (int i = 2; i < argc; ++i) {
+        string flag = argv[i];
+        if (flag == "-m" && i + 1 < argc) mode = argv[++i];
+        else if (flag == "-n" && i + 1 < argc) max_chars = strtoull(argv[++i], nullptr, 10);
+        else if (flag == "-s" && i + 1 < argc) socket_path = argv[++i];
+        else if (flag == "-w" && i + 1 < argc) workers = strtoull(argv[++i], nullptr, 10);
+        else if (flag == "-g" && i + 1 < argc) grain = strtoull(argv[++i], nullptr, 10);
+    }
+    if (mode != "words" && mode != "suffixes") {
+        cout << "Error: mode desconegut '" << mode << "' (words o suffixes)" << endl;
+        return 1;
+    }
+
+    RadixTrie trie;
+    auto start = Clock::now();
+    string error = load_index(filename, mode, max_chars, trie);
+    if (!error.empty()) {
+        cout << "Error: " << error << endl;
+        return 1;
+    }
+    cout << "Índex (" << mode << ") de " << filename << " construït en "
+         << chrono::duration<double, milli>(Clock::now() - start).count() << " ms ("
+         << trie.count_prefix("") << " claus)" << endl;
+
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path.length() >= sizeof(address.sun_path)) {
+        cout << "Error: camí del socket massa llarg" << endl;
+        return 1;
+    }
+    strcpy(address.sun_path, socket_path.c_str());
+    int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    unlink(socket_path.c_str());
+    if (listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(listener, SOMAXCONN) < 0 || !set_nonblocking(listener)) {
+        cout << "Error: no es pot escoltar a " << socket_path << ": " << strerror(errno) << endl;
+        return 1;
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_signal;  // sense SA_RESTART: epoll_wait torna amb EINTR
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = listener;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listener, &event);
+    cout << "Escoltant a " << socket_path << " amb " << workers << " treballadors (Ctrl+C per aturar)" << endl;
+
+    bool suffixes = mode == "suffixes";
+    BatchPool pool(workers, grain, [&trie, suffixes](Request& request) {
+        request.response = answer_query(trie, request.line, suffixes);
+    });
+    unordered_map<int, Connection> connections;
+    vector<epoll_event> events(256);
+    vector<Request> batch;
+    vector<int> touched;
+    vector<int> backlog, waiting;  // connexions amb línies completes per al lot següent
+    uint64_t served = 0, batches = 0;
+    size_t largest_batch = 0;
+
+    auto close_connection = [&](int fd) {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connections.erase(fd);
+    };
+    // Les peticions ja llegides d'una connexió que falla es descarten
+    auto drop_connection = [&](int fd) {
+        batch.erase(remove_if(batch.begin(), batch.end(), [fd](const Request& r) { return r.fd == fd; }), batch.end());
+        close_connection(fd);
+    };
+
+    while (!stop_requested) {
+        // Si alguna connexió ja té peticions al buffer no es pot esperar
+        int timeout = -1;
+        for (int fd : backlog) {
+            auto it = connections.find(fd);
+            if (it != connections.end() && it->second.accepts_requests()) timeout = 0;
+        }
+        int ready = epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()), timeout);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        batch.clear();
+        touched.clear();
+        for (int i = 0; i < ready; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == listener) {
+                for (int client; (client = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0;) {
+                    epoll_event client_event;
+                    memset(&client_event, 0, sizeof(client_event));
+                    client_event.events = EPOLLIN;
+                    client_event.data.fd = client;
+                    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, client, &client_event);
+                    connections[client];
+                }
+                continue;
+            }
+
+            auto it = connections.find(fd);
+            if (it == connections.end()) continue;
+            Connection& connection = it->second;
+            bool ok = true;
+            if (events[i].events & EPOLLOUT) ok = flush_output(fd, connection);
+            if (ok && connection.accepts_requests() && (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+                ok = read_requests(fd, connection, batch);
+            }
+            if (!ok) {
+                drop_connection(fd);
+                continue;
+            }
+            touched.push_back(fd);
+        }
+
+        // Les connexions amb línies pendents que no han tingut esdeveniments
+        waiting.swap(backlog);
+        backlog.clear();
+        for (int fd : waiting) {
+            auto it = connections.find(fd);
+            if (it == connections.end() || !it->second.backlog) continue;
+            if (find(touched.begin(), touched.end(), fd) != touched.end()) continue;
+            if (!it->second.accepts_requests()) {
+                backlog.push_back(fd);  // fins que el client llegeixi
+                continue;
+            }
+            if (!read_requests(fd, it->second, batch)) {
+                drop_connection(fd);
+                continue;
+            }
+            touched.push_back(fd);
+        }
+
+        if (!batch.empty()) {
+            pool.run(batch);
+            served += batch.size();
+            batches++;
+            largest_batch = max(largest_batch, batch.size());
+            for (Request& request : batch) {
+                string& output = connections[request.fd].output;
+                output += request.response;
+                output += '\n';
+            }
+        }
+
+        // Les respostes surten en l'ordre de les peticions de cada connexió
+        for (int fd : touched) {
+            auto it = connections.find(fd);
+            if (it == connections.end()) continue;
+            Connection& connection = it->second;
+            if (connection.too_long) {
+                connection.output += "ERR línia massa llarga\n";
+                connection.too_long = false;
+            }
+            if (!flush_output(fd, connection)) {
+                close_connection(fd);
+                continue;
+            }
+            if (connection.output.empty() && connection.closing && !connection.backlog) {
+                close_connection(fd);
+                continue;
+            }
+            if (connection.backlog) backlog.push_back(fd);
+            // Cal tornar a registrar-la quan es tanca o l'escriptura passa la marca
+            uint32_t wanted = connection.wanted_events();
+            if (wanted != connection.registered) {
+                epoll_event update;
+                memset(&update, 0, sizeof(update));
+                update.events = wanted;
+                update.data.fd = fd;
+                epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &update);
+                connection.registered = wanted;
+            }
+        }
+    }
+
+    for (auto& entry : connections) close(entry.first);
+    close(epoll_fd);
+    close(listener);
+    unlink(socket_path.c_str());
+    cout << "\nPeticions servides: " << served << " en " << batches << " lots (mitjana "
+         << (batches ? double(served) / batches : 0.0) << ", màxim " << largest_batch << ")" << endl;
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include "../include/asyncTrie.h"
+
+/**
+ * @brief Estat compartit d'una enumeració: els trossos acabats esperen a
+ * 'slots' fins que tots els anteriors s'han lliurat
+ */
+struct AsyncTrie::Enumeration {
+    mutex lock;
+    vector<vector<string>> slots;
+    vector<char> ready;
+    size_t next = 0;        // primer tros encara no lliurat
+    size_t total = 0;       // paraules lliurades
+    exception_ptr error;
+    ChunkVisitor on_chunk;
+    function<void(size_t, exception_ptr)> finish;
+
+    // Amb el mutex agafat: lliura en ordre tots els trossos a punt
+    void deliver() {
+        while (next < slots.size() && ready[next]) {
+            if (!error && !slots[next].empty()) {
+                total += slots[next].size();
+                try {
+                    on_chunk(std::move(slots[next]));
+                } catch (...) {
+                    error = current_exception();
+                }
+            }
+            slots[next].clear();
+            next++;
+        }
+        if (next == slots.size()) finish(total, error);
+    }
+};
+
+AsyncTrie::AsyncTrie(unique_ptr<Trie> inner, ThreadPool& pool) : inner(std::move(inner)), pool(pool) {}
+
+future<void> AsyncTrie::insert(const string& word) {
+    return pool.submit([this, word] {
+        unique_lock<shared_mutex> guard(lock);
+        inner->insert(word);
+    });
+}
+
+future<bool> AsyncTrie::search(const string& word) const {
+    return pool.submit([this, word] {
+        shared_lock<shared_mutex> guard(lock);
+        return inner->search(word);
+    });
+}
+
+future<bool> AsyncTrie::starts_with(const string& prefix) const {
+    return pool.submit([this, prefix] {
+        shared_lock<shared_mutex> guard(lock);
+        return inner->starts_with(prefix);
+    });
+}
+
+void AsyncTrie::run_chunk(const shared_ptr<Enumeration>& state, size_t index, const string& chunk_prefix) const {
+    vector<string> words;
+    exception_ptr error;
+    try {
+        shared_lock<shared_mutex> guard(lock);
+        // El tros 0 és la paraula igual al prefix; la resta, un byte més
+        if (index == 0) {
+            if (inner->search(chunk_prefix)) words.push_back(chunk_prefix);
+        } else {
+            words = inner->get_words_with_prefix(chunk_prefix);
+        }
+    } catch (...) {
+        error = current_exception();
+    }
+
+    lock_guard<mutex> guard(state->lock);
+    if (error && !state->error) state->error = error;
+    state->slots[index] = std::move(words);
+    state->ready[index] = 1;
+    state->deliver();
+}
+
+void AsyncTrie::enumerate(const string& prefix, ChunkVisitor on_chunk,
+                          function<void(size_t, exception_ptr)> finish) const {
+    auto state = make_shared<Enumeration>();
+    state->on_chunk = std::move(on_chunk);
+    state->finish = std::move(finish);
+
+    pool.post([this, state, prefix] {
+        vector<string> chunks;
+        try {
+            shared_lock<shared_mutex> guard(lock);
+            if (inner->starts_with(prefix)) {
+                chunks.push_back(prefix);
+                string extended = prefix + '\0';
+                for (int c = 0; c < 256; ++c) {
+                    extended.back() = static_cast<char>(c);
+                    if (inner->starts_with(extended)) chunks.push_back(extended);
+                }
+            }
+        } catch (...) {
+            state->finish(0, current_exception());
+            return;
+        }
+
+        if (chunks.empty()) {
+            state->finish(0, nullptr);
+            return;
+        }
+        {
+            lock_guard<mutex> guard(state->lock);
+            state->slots.resize(chunks.size());
+            state->ready.assign(chunks.size(), 0);
+        }
+        // Els trossos van a la cua d'aquest fil i els altres els roben
+        for (size_t i = chunks.size(); i-- > 1;) {
+            pool.post([this, state, i, chunk = chunks[i]] { run_chunk(state, i, chunk); });
+        }
+        run_chunk(state, 0, chunks[0]);
+    });
+}
+
+future<size_t> AsyncTrie::stream_words_with_prefix(const string& prefix, ChunkVisitor on_chunk) const {
+    auto done = make_shared<promise<size_t>>();
+    future<size_t> result = done->get_future();
+    enumerate(prefix, std::move(on_chunk), [done](size_t total, exception_ptr error) {
+        if (error) done->set_exception(error);
+        else done->set_value(total);
+    });
+    return result;
+}
+
+future<vector<string>> AsyncTrie::get_words_with_prefix(const string& prefix) const {
+    auto done = make_shared<promise<vector<string>>>();
+    auto words = make_shared<vector<string>>();
+    future<vector<string>> result = done->get_future();
+    enumerate(prefix, [words](vector<string>&& chunk) {
+        words->insert(words->end(), make_move_iterator(chunk.begin()), make_move_iterator(chunk.end()));
+    }, [done, words](size_t, exception_ptr error) {
+        if (error) done->set_exception(error);
+        else done->set_value(std::move(*words));
+    });
+    return result;
+}
@@ -0,0 +1,175 @@
+#include "../include/bitRadix.h"
+
+template <unsigned Bits>
+BitRadixTrie<Bits>::BitRadixTrie() : root(make_unique<BitNode>()), nodes(1) {}
+
+// Baixa pel camí d'una clau sense crear nodes
+template <unsigned Bits>
+typename BitRadixTrie<Bits>::BitNode* BitRadixTrie<Bits>::find_node(const string& key) const {
+    BitNode* current = root.get();
+
+    for (unsigned char c : key) {
+        for (unsigned j = 0; j < digits_per_byte; ++j) {
+            current = current->children[digit(c, j)].get();
+            if (!current) return nullptr;
+        }
+    }
+
+    return current;
+}
+
+// Inicialitzar el trie amb un text (inserir tots els sufixos)
+template <unsigned Bits>
+void BitRadixTrie<Bits>::init(const string& text) {
+    clear();
+    for (size_t i = 0; i < text.length(); ++i) {
+        insert(text.substr(i), i);
+    }
+}
+
+// Inserir una paraula i la seva posició
+template <unsigned Bits>
+void BitRadixTrie<Bits>::insert(const string& word, int position) {
+    if (word.empty()) return;
+
+    BitNode* current = root.get();
+
+    for (unsigned char c : word) {
+        for (unsigned j = 0; j < digits_per_byte; ++j) {
+            auto& child = current->children[digit(c, j)];
+            if (!child) {
+                child = make_unique<BitNode>();
+                ++nodes;
+            }
+            current = child.get();
+        }
+    }
+
+    current->positions.push_back(position);
+}
+
+// Cercar paraula i retornar posicions
+template <unsigned Bits>
+vector<int> BitRadixTrie<Bits>::search(const string& word) const {
+    if (word.empty()) return {};
+
+    BitNode* node = find_node(word);
+    return node ? node->positions : vector<int>{};
+}
+
+// Funció auxiliar per recollir posicions d'un subarbre
+template <unsigned Bits>
+void BitRadixTrie<Bits>::collect_positions(const BitNode* node, vector<int>& positions) const {
+    positions.insert(positions.end(), node->positions.begin(), node->positions.end());
+
+    for (const auto& child : node->children) {
+        if (child) collect_positions(child.get(), positions);
+    }
+}
+
+// Trobar posicions de paraules que comencen amb un prefix
+template <unsigned Bits>
+vector<int> BitRadixTrie<Bits>::starts_with(const string& prefix) const {
+    vector<int> positions;
+    if (prefix.empty()) return positions;
+
+    BitNode* node = find_node(prefix);
+    if (node) collect_positions(node, positions);
+    return positions;
+}
+
+// Funció auxiliar per recollir paraules: els dígits es reagrupen en bytes
+template <unsigned Bits>
+void BitRadixTrie<Bits>::collect_words(const BitNode* node, string& key, unsigned partial, unsigned level,
+                                       vector<pair<string, int>>& results) const {
+    // Les claus només acaben en frontera de byte (level == 0)
+    for (int pos : node->positions) {
+        results.push_back({key, pos});
+    }
+
+    for (size_t d = 0; d < fanout; ++d) {
+        const BitNode* child = node->children[d].get();
+        if (!child) continue;
+
+        unsigned next = (partial << Bits) | static_cast<unsigned>(d);
+        if (level + 1 == digits_per_byte) {
+            key.push_back(static_cast<char>(next));
+            collect_words(child, key, 0, 0, results);
+            key.pop_back();
+        } else {
+            collect_words(child, key, next, level + 1, results);
+        }
+    }
+}
+
+// Autocomplete: paraules que comencen per un prefix
+template <unsigned Bits>
+vector<pair<string, int>> BitRadixTrie<Bits>::autocomplete(const string& prefix) const {
+    vector<pair<string, int>> results;
+
+    BitNode* node = find_node(prefix);
+    if (!node) return results;
+
+    string key = prefix;
+    collect_words(node, key, 0, 0, results);
+    return results;
+}
+
+// Obtenir totes les paraules del trie
+template <unsigned Bits>
+vector<pair<string, int>> BitRadixTrie<Bits>::get_words() const {
+    return autocomplete("");
+}
+
+template <unsigned Bits>
+void BitRadixTrie<Bits>::clear() {
+    root = make_unique<BitNode>();
+    nodes = 1;
+}
+
+template <unsigned Bits>
+bool BitRadixTrie<Bits>::empty() const {
+    return nodes == 1 && root->positions.empty();
+}
+
+// Funció auxiliar de profile()
+template <unsigned Bits>
+void BitRadixTrie<Bits>::profile_subtree(const BitNode* node, size_t depth, TrieProfile& report) const {
+    size_t fanout_used = 0;
+    for (const auto& child : node->children) {
+        if (child) fanout_used++;
+    }
+
+    report.nodes++;
+    report.node_header_bytes += sizeof(BitNode) - sizeof(node->children);
+    report.child_table_bytes += sizeof(node->children);
+    report.empty_child_slots += fanout - fanout_used;
+    report.add_allocation(sizeof(BitNode));
+    report.fanout_histogram[fanout_used]++;
+    report.depth_histogram[depth]++;
+
+    if (!node->positions.empty()) {
+        report.keys++;
+        report.positions += node->positions.size();
+        report.position_bytes += node->positions.capacity() * sizeof(int);
+        report.add_allocation(node->positions.capacity() * sizeof(int));
+    }
+
+    for (const auto& child : node->children) {
+        if (child) profile_subtree(child.get(), depth + 1, report);
+    }
+}
+
+template <unsigned Bits>
+TrieProfile BitRadixTrie<Bits>::profile() const {
+    TrieProfile report;
+    report.backend = "BitRadixTrie<" + to_string(Bits) + ">";
+    profile_subtree(root.get(), 0, report);
+    return report;
+}
+
+// Instanciacions explícites dels amples suportats
+template class BitRadixTrie<1>;
+template class BitRadixTrie<2>;
+template class BitRadixTrie<4>;
+template class BitRadixTrie<8>;
@@ -0,0 +1,39 @@
+#include "../include/bloomFilter.h"
+#include <algorithm>
+
+// Multiplicadors senars per derivar els 8 bits de cada bloc dels 32 bits
+// baixos del hash: cada producte en dóna 6 (posició dins d'una paraula)
+static const uint32_t salts[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                  0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+BlockedBloomFilter::BlockedBloomFilter(size_t expected_items, size_t bits_per_item)
+    : max_items(max<size_t>(1, expected_items)) {
+    size_t bits = max_items * max<size_t>(1, bits_per_item);
+    blocks.resize(max<size_t>(1, (bits + 511) / 512));
+    clear();
+}
+
+void BlockedBloomFilter::add(uint64_t hash) {
+    Block& block = blocks[block_index(hash)];
+    uint32_t low = static_cast<uint32_t>(hash);
+    for (size_t i = 0; i < 8; ++i) {
+        block.words[i] |= uint64_t(1) << ((low * salts[i]) >> 26);
+    }
+    items++;
+}
+
+bool BlockedBloomFilter::may_contain(uint64_t hash) const {
+    const Block& block = blocks[block_index(hash)];
+    uint32_t low = static_cast<uint32_t>(hash);
+    // Sense branques dins del bucle: el compilador ho pot vectoritzar
+    uint64_t missing = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        missing |= ~block.words[i] & (uint64_t(1) << ((low * salts[i]) >> 26));
+    }
+    return missing == 0;
+}
+
+void BlockedBloomFilter::clear() {
+    fill(blocks.begin(), blocks.end(), Block{});
+    items = 0;
+}
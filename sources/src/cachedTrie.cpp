@@ -0,0 +1,185 @@
+#include "../include/cachedTrie.h"
+#include <algorithm>
+
+CachedTrie::CachedTrie(unique_ptr<Trie> inner, size_t capacity, size_t shards)
+    : inner(std::move(inner)), shards(max<size_t>(1, shards)) {
+    shard_capacity = max<size_t>(1, capacity / this->shards.size());
+}
+
+CachedTrie::Entry* CachedTrie::find(Shard& shard, string_view prefix) const {
+    auto it = shard.index.find(prefix);
+    if (it == shard.index.end()) return nullptr;
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    return &*it->second;
+}
+
+CachedTrie::Entry& CachedTrie::entry_for(Shard& shard, const string& prefix) const {
+    if (Entry* entry = find(shard, prefix)) return *entry;
+    if (shard.lru.size() >= shard_capacity) {
+        shard.index.erase(shard.lru.back().prefix);
+        shard.lru.pop_back();
+    }
+    shard.lru.emplace_front();
+    shard.lru.front().prefix = prefix;
+    // La clau de l'índex apunta al prefix de l'entrada, que no es mou
+    shard.index.emplace(shard.lru.front().prefix, shard.lru.begin());
+    return shard.lru.front();
+}
+
+// search() i starts_with(): el resultat es calcula fora del mutex i només es
+// guarda si cap invalidació del shard no s'hi ha creuat
+bool CachedTrie::cached_flag(const string& prefix, int8_t Entry::*flag,
+                             bool (Trie::*query)(const string&) const) const {
+    Shard& shard = shard_of(prefix);
+    uint64_t generation;
+    {
+        lock_guard<mutex> guard(shard.lock);
+        Entry* entry = find(shard, prefix);
+        if (entry && entry->*flag >= 0) {
+            shard.hits++;
+            return entry->*flag;
+        }
+        shard.misses++;
+        generation = shard.generation;
+    }
+
+    bool result = ((*inner).*query)(prefix);
+    lock_guard<mutex> guard(shard.lock);
+    if (shard.generation == generation) entry_for(shard, prefix).*flag = result;
+    return result;
+}
+
+bool CachedTrie::search(const string& word) const {
+    return cached_flag(word, &Entry::found, &Trie::search);
+}
+
+bool CachedTrie::starts_with(const string& prefix) const {
+    return cached_flag(prefix, &Entry::has_prefix, &Trie::starts_with);
+}
+
+vector<string> CachedTrie::get_words_with_prefix(const string& prefix) const {
+    return get_words_with_prefix(prefix, 0);
+}
+
+// Primeres 'limit' paraules en ordre lexicogràfic (totes, sense ordenar, si és 0)
+static vector<string> first_words(vector<string> words, size_t limit) {
+    if (limit > 0 && words.size() > limit) {
+        partial_sort(words.begin(), words.begin() + limit, words.end());
+        words.resize(limit);
+    } else if (limit > 0) {
+        sort(words.begin(), words.end());
+    }
+    return words;
+}
+
+vector<string> CachedTrie::get_words_with_prefix(const string& prefix, size_t limit) const {
+    Shard& shard = shard_of(prefix);
+    shared_ptr<const vector<string>> cached;
+    size_t cached_limit = 0;
+    uint64_t generation;
+    {
+        lock_guard<mutex> guard(shard.lock);
+        if (Entry* entry = find(shard, prefix)) {
+            // El mateix límit, o un resultat del qual es pot treure: un de
+            // límit més gran (o que no l'omple) ja ordenat, o el de límit 0
+            for (const auto& words : entry->words) {
+                bool usable = words.first == limit ||
+                              (limit > 0 && (words.first == 0 || words.first > limit || words.second->size() < words.first));
+                if (usable && (!cached || words.first == limit)) {
+                    cached = words.second;
+                    cached_limit = words.first;
+                }
+            }
+        }
+        if (cached) shard.hits++;
+        else shard.misses++;
+        generation = shard.generation;
+    }
+    // La còpia del resultat es fa fora del mutex
+    if (cached && cached_limit == limit) return *cached;
+    if (cached && cached_limit == 0) return first_words(*cached, limit);
+    if (cached) return vector<string>(cached->begin(), cached->begin() + min(limit, cached->size()));
+
+    vector<string> words = first_words(inner->get_words_with_prefix(prefix), limit);
+
+    lock_guard<mutex> guard(shard.lock);
+    if (shard.generation == generation) {
+        // Un fallo concurrent pel mateix límit substitueix el resultat; els
+        // límits guardats per entrada estan fitats
+        auto& stored = entry_for(shard, prefix).words;
+        auto result = make_shared<const vector<string>>(words);
+        auto same = find_if(stored.begin(), stored.end(), [limit](const auto& w) { return w.first == limit; });
+        if (same != stored.end()) {
+            same->second = result;
+        } else {
+            if (stored.size() == MaxLimitsPerEntry) stored.erase(stored.begin());
+            stored.emplace_back(limit, result);
+        }
+    }
+    return words;
+}
+
+void CachedTrie::invalidate(const string& word) {
+    string_view view(word);
+    for (size_t length = 0; length <= view.length(); ++length) {
+        string_view prefix = view.substr(0, length);
+        Shard& shard = shard_of(prefix);
+        lock_guard<mutex> guard(shard.lock);
+        shard.generation++;
+        auto it = shard.index.find(prefix);
+        if (it == shard.index.end()) continue;
+        auto position = it->second;
+        shard.index.erase(it);
+        shard.lru.erase(position);
+    }
+}
+
+void CachedTrie::insert(const string& word) {
+    inner->insert(word);
+    invalidate(word);
+}
+
+vector<string> CachedTrie::get_all_words() const {
+    return inner->get_all_words();
+}
+
+bool CachedTrie::empty() const {
+    return inner->empty();
+}
+
+void CachedTrie::clear() {
+    inner->clear();
+    for (Shard& shard : shards) {
+        lock_guard<mutex> guard(shard.lock);
+        shard.generation++;
+        shard.index.clear();
+        shard.lru.clear();
+    }
+}
+
+uint64_t CachedTrie::hits() const {
+    uint64_t total = 0;
+    for (const Shard& shard : shards) {
+        lock_guard<mutex> guard(shard.lock);
+        total += shard.hits;
+    }
+    return total;
+}
+
+uint64_t CachedTrie::misses() const {
+    uint64_t total = 0;
+    for (const Shard& shard : shards) {
+        lock_guard<mutex> guard(shard.lock);
+        total += shard.misses;
+    }
+    return total;
+}
+
+size_t CachedTrie::size() const {
+    size_t total = 0;
+    for (const Shard& shard : shards) {
+        lock_guard<mutex> guard(shard.lock);
+        total += shard.lru.size();
+    }
+    return total;
+}
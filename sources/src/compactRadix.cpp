@@ -0,0 +1,277 @@
+#include "../include/compactRadix.h"
+#include <algorithm>
+#include <cstring>
+#include <deque>
+
+CompactRadixTrie::CompactRadixTrie() : node_layout(Layout::VanEmdeBoas) {
+    nodes.push_back(CompactNode{0, 0, 0, 0, 0, 0, 0, false, InlineLabel});
+}
+
+CompactRadixTrie::CompactRadixTrie(const RadixTrie& trie, Layout layout)
+    : text(trie.source_text), pool(trie.label_pool), node_layout(layout) {
+    const SourceNode* root = trie.root.get();
+
+    // 1. Ordre dels nodes al buffer (l'arrel sempre és la primera)
+    vector<const SourceNode*> order;
+    if (layout == Layout::BreadthFirst) layout_breadth_first(root, order);
+    else if (layout == Layout::Preorder) layout_preorder(root, order);
+    else layout_van_emde_boas(root, height(root), order);
+
+    unordered_map<const SourceNode*, uint32_t> index;
+    index.reserve(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        index[order[i]] = static_cast<uint32_t>(i);
+    }
+
+    // 2. Nodes, etiquetes i arestes en l'ordre del layout
+    nodes.resize(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        const SourceNode* node = order[i];
+        CompactNode& compact = nodes[i];
+
+        // Les del text i del pool ja tenen desplaçaments de 32 bits al RadixTrie
+        const RadixTrie::Label& label = node->label;
+        compact.label_length = trie.label_length(label);
+        if (label.source == RadixTrie::InlineLabel) {
+            compact.label_source = InlineLabel;
+            compact.label_offset = inline_labels.length();
+            inline_labels.append(label.bytes, compact.label_length);
+        } else {
+            compact.label_source = label.source == RadixTrie::PoolLabel ? PoolLabel : TextLabel;
+            compact.label_offset = label.offset;
+        }
+
+        compact.first_edge = edge_chars.length();
+        compact.edge_count = node->children.size();
+        for (const SourceNode* child : children_of(node)) {
+            edge_chars.push_back(trie.label_data(child->label)[0]);
+            edge_targets.push_back(index.at(child));
+        }
+        compact.is_end_of_key = node->is_end_of_key;
+    }
+
+    // 3. Posicions en preordre, independentment del layout
+    copy_positions(root, index);
+}
+
+// Fills d'un node, en l'ordre del RadixTrie (pel primer byte de l'etiqueta)
+vector<const CompactRadixTrie::SourceNode*> CompactRadixTrie::children_of(const SourceNode* node) {
+    vector<const SourceNode*> children;
+    children.reserve(node->children.size());
+    for (const auto& entry : node->children) children.push_back(entry.second.get());
+    return children;
+}
+
+// Alçada en nivells del subarbre (una fulla té alçada 1)
+size_t CompactRadixTrie::height(const SourceNode* node) {
+    size_t levels = 0;
+    for (const auto& pair : node->children) {
+        levels = max(levels, height(pair.second.get()));
+    }
+    return levels + 1;
+}
+
+void CompactRadixTrie::layout_breadth_first(const SourceNode* root, vector<const SourceNode*>& order) {
+    deque<const SourceNode*> pending{root};
+    while (!pending.empty()) {
+        const SourceNode* node = pending.front();
+        pending.pop_front();
+        order.push_back(node);
+        for (const SourceNode* child : children_of(node)) pending.push_back(child);
+    }
+}
+
+void CompactRadixTrie::layout_preorder(const SourceNode* node, vector<const SourceNode*>& order) {
+    order.push_back(node);
+    for (const SourceNode* child : children_of(node)) layout_preorder(child, order);
+}
+
+// Layout de van Emde Boas: els primers levels/2 nivells del subarbre es
+// col·loquen (recursivament) junts, i després cada subarbre que penja
+// d'aquest arbre superior, també recursivament
+void CompactRadixTrie::layout_van_emde_boas(const SourceNode* node, size_t levels,
+                                            vector<const SourceNode*>& order) {
+    if (levels <= 1) {
+        order.push_back(node);
+        return;
+    }
+
+    size_t top = levels / 2;
+    layout_van_emde_boas(node, top, order);
+
+    vector<const SourceNode*> frontier;
+    collect_frontier(node, top, frontier);
+    for (const SourceNode* bottom : frontier) {
+        layout_van_emde_boas(bottom, levels - top, order);
+    }
+}
+
+// Descendents de 'node' a profunditat 'depth' (relativa), d'esquerra a dreta
+void CompactRadixTrie::collect_frontier(const SourceNode* node, size_t depth,
+                                        vector<const SourceNode*>& frontier) {
+    if (depth == 0) {
+        frontier.push_back(node);
+        return;
+    }
+    for (const SourceNode* child : children_of(node)) {
+        collect_frontier(child, depth - 1, frontier);
+    }
+}
+
+void CompactRadixTrie::copy_positions(const SourceNode* node,
+                                      const unordered_map<const SourceNode*, uint32_t>& index) {
+    uint32_t i = index.at(node);
+    nodes[i].first_position = positions.size();
+    if (node->is_end_of_key) {
+        positions.insert(positions.end(), node->positions.begin(), node->positions.end());
+    }
+    nodes[i].own_positions_end = positions.size();
+
+    for (const SourceNode* child : children_of(node)) copy_positions(child, index);
+    nodes[i].subtree_end = positions.size();
+}
+
+uint32_t CompactRadixTrie::find_child(uint32_t node, char c) const {
+    const CompactNode& compact = nodes[node];
+    const char* first = edge_chars.data() + compact.first_edge;
+    const void* hit = memchr(first, c, compact.edge_count);
+    if (!hit) return npos;
+    return edge_targets[compact.first_edge + (static_cast<const char*>(hit) - first)];
+}
+
+uint32_t CompactRadixTrie::find_node(const string& key, size_t& depth) const {
+    uint32_t current = 0;
+    depth = 0;
+
+    while (true) {
+        uint32_t child = find_child(current, key[depth]);
+        if (child == npos) return npos;
+
+        const CompactNode& compact = nodes[child];
+        size_t remaining = key.length() - depth;
+        size_t limit = min<size_t>(remaining, compact.label_length);
+        const char* label = label_data(compact);
+        size_t match_len = 0;
+        while (match_len < limit && key[depth + match_len] == label[match_len]) match_len++;
+
+        // La clau acaba dins (o al final) de l'etiqueta del fill
+        if (match_len == remaining) return child;
+        if (match_len < compact.label_length) return npos;
+
+        depth += match_len;
+        current = child;
+    }
+}
+
+vector<int> CompactRadixTrie::search(const string& word) const {
+    if (word.empty()) return {};
+
+    size_t depth;
+    uint32_t node = find_node(word, depth);
+    if (node == npos) return {};
+
+    const CompactNode& compact = nodes[node];
+    if (depth + compact.label_length != word.length() || !compact.is_end_of_key) return {};
+    return vector<int>(positions.begin() + compact.first_position,
+                       positions.begin() + compact.own_positions_end);
+}
+
+vector<int> CompactRadixTrie::starts_with(const string& prefix) const {
+    uint32_t node = 0;
+    if (!prefix.empty()) {
+        size_t depth;
+        node = find_node(prefix, depth);
+        if (node == npos) return {};
+    }
+
+    // Les posicions del subarbre són contigües
+    return vector<int>(positions.begin() + nodes[node].first_position,
+                       positions.begin() + nodes[node].subtree_end);
+}
+
+void CompactRadixTrie::collect_words(uint32_t node, string& prefix,
+                                     vector<pair<string, int>>& results) const {
+    const CompactNode& compact = nodes[node];
+    size_t previous = prefix.length();
+    prefix.append(label_data(compact), compact.label_length);
+
+    for (uint32_t i = compact.first_position; i < compact.own_positions_end; ++i) {
+        results.push_back({prefix, positions[i]});
+    }
+    for (uint32_t e = compact.first_edge; e < compact.first_edge + compact.edge_count; ++e) {
+        collect_words(edge_targets[e], prefix, results);
+    }
+
+    prefix.resize(previous);
+}
+
+vector<pair<string, int>> CompactRadixTrie::autocomplete(const string& prefix) const {
+    vector<pair<string, int>> results;
+    if (prefix.empty()) return get_words();
+
+    size_t depth;
+    uint32_t node = find_node(prefix, depth);
+    if (node == npos) return results;
+
+    string word = prefix.substr(0, depth);
+    collect_words(node, word, results);
+    return results;
+}
+
+vector<pair<string, int>> CompactRadixTrie::get_words() const {
+    vector<pair<string, int>> results;
+    string word;
+    collect_words(0, word, results);
+    return results;
+}
+
+bool CompactRadixTrie::empty() const {
+    return nodes[0].edge_count == 0;
+}
+
+TrieProfile CompactRadixTrie::profile() const {
+    TrieProfile report;
+    report.backend = string("CompactRadixTrie (") + layout_name(node_layout) + ")";
+    report.nodes = nodes.size();
+
+    // Una reserva per vector
+    report.node_header_bytes = nodes.capacity() * sizeof(CompactNode);
+    report.child_table_bytes = edge_chars.capacity() + edge_targets.capacity() * sizeof(uint32_t);
+    report.position_bytes = positions.capacity() * sizeof(int);
+    report.add_allocation(report.node_header_bytes);
+    report.add_allocation(edge_chars.capacity());
+    report.add_allocation(edge_targets.capacity() * sizeof(uint32_t));
+    report.add_allocation(report.position_bytes);
+    for (const string* buffer : {&text, &pool, &inline_labels}) {
+        size_t bytes = TrieProfile::string_heap_bytes(*buffer);
+        report.label_bytes += bytes;
+        report.add_allocation(bytes);
+    }
+
+    // Forma: recorregut en profunditat des de l'arrel amb una pila
+    vector<pair<uint32_t, size_t>> pending{{0, 0}};
+    while (!pending.empty()) {
+        auto [node, depth] = pending.back();
+        pending.pop_back();
+        const CompactNode& compact = nodes[node];
+        report.depth_histogram[depth]++;
+        report.fanout_histogram[compact.edge_count]++;
+        if (depth > 0) report.label_length_histogram[compact.label_length]++;
+        if (compact.is_end_of_key) {
+            report.keys++;
+            report.positions += compact.own_positions_end - compact.first_position;
+        }
+        for (uint32_t e = compact.first_edge; e < compact.first_edge + compact.edge_count; ++e) {
+            pending.push_back({edge_targets[e], depth + 1});
+        }
+    }
+    return report;
+}
+
+const char* CompactRadixTrie::layout_name(Layout layout) {
+    switch (layout) {
+        case Layout::BreadthFirst: return "BFS";
+        case Layout::Preorder: return "preordre";
+        default: return "van Emde Boas";
+    }
+}
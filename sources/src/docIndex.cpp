@@ -0,0 +1,329 @@
+#include "../include/docIndex.h"
+#include "../include/tokenizer.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+// Primer índex de [lo, hi) amb data[i] >= target: salts de mida 1, 2, 4...
+// des de lo i cerca binària a l'últim interval
+static size_t gallop(const uint32_t* data, size_t lo, size_t hi, uint32_t target) {
+    size_t step = 1;
+    size_t bound = lo;
+    while (bound < hi && data[bound] < target) {
+        lo = bound + 1;
+        bound += step;
+        step <<= 1;
+    }
+    return lower_bound(data + lo, data + min(bound, hi), target) - data;
+}
+
+// Parteix un text en termes normalitzats
+static vector<string> split_terms(const string& text) {
+    Tokenizer tokenizer;
+    vector<string> result;
+    for (const Token& token : tokenizer.tokenize(text)) result.emplace_back(token.text);
+    return result;
+}
+
+string DocumentIndex::normalize(const string& term) {
+    // Mateix camí que els documents: "don't" són dos termes i no "dont"
+    vector<string> words = split_terms(term);
+    return words.size() == 1 ? words.front() : string();
+}
+
+int DocumentIndex::term_id(const string& term) const {
+    if (term.empty()) return -1;
+    vector<int> ids = terms.search(term);
+    return ids.empty() ? -1 : ids.front();
+}
+
+void DocumentIndex::add_occurrence(const string& term, uint32_t doc, uint32_t word) {
+    int id = term_id(term);
+    if (id < 0) {
+        id = static_cast<int>(postings.size());
+        terms.insert(term, id);
+        postings.emplace_back();
+    }
+
+    TermPostings& list = postings[id];
+    if (list.docs.empty() || list.docs.back() != doc) {
+        list.docs.push_back(doc);
+        list.doc_begin.push_back(list.words.size());
+    }
+    list.words.push_back(word);
+    total_postings++;
+}
+
+uint32_t DocumentIndex::add_document(const string& name, const string& text) {
+    uint32_t doc = documents.size();
+    documents.push_back(Document{name, 0, {0}, {}});
+    Document& document = documents.back();
+
+    uint32_t word = 0;
+    bool line_blank = true;
+    bool new_paragraph = true;
+    string term;
+
+    // Bytes entre termes: salts de línia i línies en blanc
+    auto scan_gap = [&](size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) {
+            unsigned char c = text[i];
+            if (c == '\n') {
+                // Una línia en blanc tanca el paràgraf actual
+                if (line_blank) new_paragraph = true;
+                line_blank = true;
+                document.line_starts.push_back(word);
+            } else if (!isspace(c)) {
+                line_blank = false;
+            }
+        }
+    };
+
+    // Saltar la marca d'ordre de bytes UTF-8 si n'hi ha
+    size_t start = text.compare(0, 3, "\xEF\xBB\xBF") == 0 ? 3 : 0;
+    Tokenizer tokenizer;
+    size_t previous_end = start;
+    for (const Token& token : tokenizer.tokenize(text.data() + start, text.length() - start, start)) {
+        scan_gap(previous_end, token.offset);
+        previous_end = token.offset + token.text.length();
+
+        line_blank = false;
+        if (new_paragraph) {
+            document.paragraph_starts.push_back(word);
+            new_paragraph = false;
+        }
+        term.assign(token.text);
+        add_occurrence(term, doc, word++);
+    }
+    scan_gap(previous_end, text.length());
+
+    document.word_count = word;
+    return doc;
+}
+
+bool DocumentIndex::add_file(const string& path) {
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) return false;
+    ostringstream buffer;
+    buffer << file.rdbuf();
+    add_document(path, buffer.str());
+    return true;
+}
+
+size_t DocumentIndex::add_directory(const string& path) {
+    vector<string> files;
+    error_code error;
+    for (const auto& entry : filesystem::directory_iterator(path, error)) {
+        if (entry.is_regular_file()) files.push_back(entry.path().string());
+    }
+    sort(files.begin(), files.end());
+
+    size_t added = 0;
+    for (const string& file : files) {
+        if (add_file(file)) added++;
+    }
+    return added;
+}
+
+DocumentIndex::Posting DocumentIndex::make_posting(uint32_t doc, uint32_t word) const {
+    const Document& document = documents[doc];
+    // La darrera línia/paràgraf que comença abans o a la paraula (les línies
+    // buides repeteixen el començament de la següent)
+    auto line = upper_bound(document.line_starts.begin(), document.line_starts.end(), word);
+    auto paragraph = upper_bound(document.paragraph_starts.begin(), document.paragraph_starts.end(), word);
+    return Posting{doc,
+                   static_cast<uint32_t>(line - document.line_starts.begin() - 1),
+                   static_cast<uint32_t>(paragraph - document.paragraph_starts.begin() - 1),
+                   word};
+}
+
+vector<DocumentIndex::Posting> DocumentIndex::lookup(const string& term) const {
+    vector<Posting> results;
+    int id = term_id(normalize(term));
+    if (id < 0) return results;
+
+    const TermPostings& list = postings[id];
+    results.reserve(list.words.size());
+    for (size_t i = 0; i < list.docs.size(); ++i) {
+        for (uint32_t w = list.doc_begin[i]; w < list.end_of(i); ++w) {
+            results.push_back(make_posting(list.docs[i], list.words[w]));
+        }
+    }
+    return results;
+}
+
+vector<DocumentIndex::Posting> DocumentIndex::lookup(const string& term, uint32_t doc) const {
+    vector<Posting> results;
+    int id = term_id(normalize(term));
+    if (id < 0) return results;
+
+    const TermPostings& list = postings[id];
+    size_t cursor = 0;
+    uint32_t begin, end;
+    if (!document_range(list, doc, cursor, begin, end)) return results;
+
+    for (uint32_t w = begin; w < end; ++w) {
+        results.push_back(make_posting(doc, list.words[w]));
+    }
+    return results;
+}
+
+vector<uint32_t> DocumentIndex::common_documents(const vector<const TermPostings*>& lists, uint32_t doc) {
+    // Partim de la llista de documents més curta
+    const TermPostings* shortest = lists.front();
+    for (const TermPostings* list : lists) {
+        if (list->docs.size() < shortest->docs.size()) shortest = list;
+    }
+    vector<uint32_t> docs = doc == all_documents ? shortest->docs : vector<uint32_t>{doc};
+
+    for (const TermPostings* list : lists) {
+        size_t cursor = 0, kept = 0;
+        for (uint32_t d : docs) {
+            cursor = gallop(list->docs.data(), cursor, list->docs.size(), d);
+            if (cursor == list->docs.size()) break;
+            if (list->docs[cursor] == d) docs[kept++] = d;
+        }
+        docs.resize(kept);
+    }
+    return docs;
+}
+
+bool DocumentIndex::document_range(const TermPostings& list, uint32_t doc, size_t& cursor,
+                                   uint32_t& begin, uint32_t& end) {
+    cursor = gallop(list.docs.data(), cursor, list.docs.size(), doc);
+    if (cursor == list.docs.size() || list.docs[cursor] != doc) return false;
+    begin = list.doc_begin[cursor];
+    end = list.end_of(cursor);
+    return true;
+}
+
+vector<DocumentIndex::Posting> DocumentIndex::phrase_search(const string& phrase, uint32_t doc) const {
+    vector<Posting> results;
+    vector<string> words = split_terms(phrase);
+    if (words.empty()) return results;
+
+    vector<const TermPostings*> lists;
+    for (const string& word : words) {
+        int id = term_id(word);
+        if (id < 0) return results;
+        lists.push_back(&postings[id]);
+    }
+
+    // El terme més rar guia la intersecció; la resta es comproven a salts
+    vector<size_t> order(lists.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    sort(order.begin(), order.end(), [&](size_t x, size_t y) {
+        return lists[x]->words.size() < lists[y]->words.size();
+    });
+
+    vector<size_t> doc_cursor(lists.size(), 0);
+    vector<uint32_t> candidates;
+    for (uint32_t d : common_documents(lists, doc)) {
+        // Candidats: paraula inicial de la frase segons el terme més rar
+        uint32_t begin, end;
+        size_t rarest = order.front();
+        document_range(*lists[rarest], d, doc_cursor[rarest], begin, end);
+        candidates.clear();
+        for (uint32_t w = begin; w < end; ++w) {
+            uint32_t word = lists[rarest]->words[w];
+            if (word >= rarest) candidates.push_back(word - rarest);
+        }
+
+        // Cada terme i ha d'aparèixer a candidat + i
+        for (size_t k = 1; k < order.size() && !candidates.empty(); ++k) {
+            size_t i = order[k];
+            document_range(*lists[i], d, doc_cursor[i], begin, end);
+            const uint32_t* data = lists[i]->words.data();
+            size_t cursor = begin, kept = 0;
+            for (uint32_t start : candidates) {
+                cursor = gallop(data, cursor, end, start + i);
+                if (cursor == end) break;
+                if (data[cursor] == start + i) candidates[kept++] = start;
+            }
+            candidates.resize(kept);
+        }
+
+        for (uint32_t start : candidates) results.push_back(make_posting(d, start));
+    }
+    return results;
+}
+
+vector<pair<DocumentIndex::Posting, DocumentIndex::Posting>>
+DocumentIndex::near(const string& a, const string& b, uint32_t k, uint32_t doc) const {
+    vector<pair<Posting, Posting>> results;
+    int id_a = term_id(normalize(a));
+    int id_b = term_id(normalize(b));
+    if (id_a < 0 || id_b < 0) return results;
+
+    const TermPostings& list_a = postings[id_a];
+    const TermPostings& list_b = postings[id_b];
+    size_t cursor_a = 0, cursor_b = 0;
+
+    for (uint32_t d : common_documents({&list_a, &list_b}, doc)) {
+        uint32_t begin_a, end_a, begin_b, end_b;
+        document_range(list_a, d, cursor_a, begin_a, end_a);
+        document_range(list_b, d, cursor_b, begin_b, end_b);
+
+        const uint32_t* data = list_b.words.data();
+        size_t cursor = begin_b;
+        for (uint32_t w = begin_a; w < end_a; ++w) {
+            uint32_t word = list_a.words[w];
+            // Primera ocurrència de b dins de la finestra [word - k, word + k]
+            cursor = gallop(data, cursor, end_b, word > k ? word - k : 0);
+
+            // word + k es pot desbordar: es compara la distància
+            uint32_t best = 0, best_distance = 0;
+            bool found = false;
+            for (size_t j = cursor; j < end_b && (data[j] <= word || data[j] - word <= k); ++j) {
+                if (data[j] == word) continue;  // mateixa ocurrència si a == b
+                uint32_t distance = data[j] > word ? data[j] - word : word - data[j];
+                if (!found || distance < best_distance) {
+                    best = data[j];
+                    best_distance = distance;
+                    found = true;
+                }
+            }
+            if (found) {
+                results.push_back({make_posting(d, word), make_posting(d, best)});
+            }
+        }
+    }
+    return results;
+}
+
+vector<string> DocumentIndex::terms_with_prefix(const string& prefix) const {
+    vector<string> results;
+    string term = normalize(prefix);
+    if (term.empty() && !prefix.empty()) return results;
+    for (const auto& entry : terms.autocomplete(term)) {
+        results.push_back(entry.first);
+    }
+    sort(results.begin(), results.end());
+    return results;
+}
+
+int DocumentIndex::find_document(const string& name) const {
+    for (size_t i = 0; i < documents.size(); ++i) {
+        if (documents[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+size_t DocumentIndex::postings_bytes() const {
+    size_t bytes = postings.capacity() * sizeof(TermPostings);
+    for (const TermPostings& list : postings) {
+        bytes += (list.docs.capacity() + list.doc_begin.capacity() + list.words.capacity()) * sizeof(uint32_t);
+    }
+    for (const Document& document : documents) {
+        bytes += (document.line_starts.capacity() + document.paragraph_starts.capacity()) * sizeof(uint32_t);
+    }
+    return bytes;
+}
+
+void DocumentIndex::clear() {
+    terms.clear();
+    postings.clear();
+    documents.clear();
+    total_postings = 0;
+}
@@ -0,0 +1,101 @@
+#include "../include/filteredTrie.h"
+#include <algorithm>
+
+static const uint64_t WordSeed = 0x9e3779b97f4a7c15ULL;
+static const uint64_t PrefixSeed = 0xc2b2ae3d27d4eb4fULL;
+
+// Entrades previstes per paraula: la paraula i els prefixos que encara no hi
+// són (a la pràctica els prefixos curts es comparteixen gairebé tots)
+static const size_t EntriesPerWord = 2;
+
+FilteredTrie::FilteredTrie(unique_ptr<Trie> inner, size_t prefix_length, size_t expected_words)
+    : inner(std::move(inner)), max_prefix(prefix_length), bloom(max<size_t>(1, expected_words) * EntriesPerWord) {
+    if (!this->inner->empty()) rebuild(bloom.capacity());
+}
+
+// Barreja final (splitmix64) amb la longitud i la llavor del tipus d'entrada
+uint64_t FilteredTrie::finish(uint64_t state, size_t length, uint64_t seed) {
+    uint64_t x = state ^ seed ^ (uint64_t(length) * 0xbf58476d1ce4e5b9ULL);
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Només s'afegeixen les entrades que el filtre encara no dóna per bones: no
+// canvia cap resposta i size() compta aproximadament les entrades diferents
+void FilteredTrie::add_word(const string& word) {
+    uint64_t state = 0;
+    for (size_t i = 0; i < word.length(); ++i) {
+        state = extend(state, static_cast<unsigned char>(word[i]));
+        if (i < max_prefix) {
+            uint64_t hash = finish(state, i + 1, PrefixSeed);
+            if (!bloom.may_contain(hash)) bloom.add(hash);
+        }
+    }
+    uint64_t hash = finish(state, word.length(), WordSeed);
+    if (!bloom.may_contain(hash)) bloom.add(hash);
+}
+
+void FilteredTrie::rebuild(size_t capacity) {
+    bloom = BlockedBloomFilter(capacity);
+    for (const string& word : inner->get_all_words()) add_word(word);
+}
+
+void FilteredTrie::insert(const string& word) {
+    inner->insert(word);
+    add_word(word);
+    if (bloom.size() > bloom.capacity()) rebuild(bloom.capacity() * 2);
+}
+
+bool FilteredTrie::may_have_prefix(const string& prefix) const {
+    size_t length = min(prefix.length(), max_prefix);
+    if (length == 0) return true;
+    uint64_t state = 0;
+    for (size_t i = 0; i < length; ++i) state = extend(state, static_cast<unsigned char>(prefix[i]));
+    return bloom.may_contain(finish(state, length, PrefixSeed));
+}
+
+bool FilteredTrie::search(const string& word) const {
+    uint64_t state = 0;
+    for (unsigned char c : word) state = extend(state, c);
+    if (!bloom.may_contain(finish(state, word.length(), WordSeed))) {
+        rejected_queries++;
+        return false;
+    }
+    forwarded_queries++;
+    return inner->search(word);
+}
+
+bool FilteredTrie::starts_with(const string& prefix) const {
+    if (!may_have_prefix(prefix)) {
+        rejected_queries++;
+        return false;
+    }
+    forwarded_queries++;
+    return inner->starts_with(prefix);
+}
+
+vector<string> FilteredTrie::get_words_with_prefix(const string& prefix) const {
+    if (!may_have_prefix(prefix)) {
+        rejected_queries++;
+        return {};
+    }
+    forwarded_queries++;
+    return inner->get_words_with_prefix(prefix);
+}
+
+vector<string> FilteredTrie::get_all_words() const {
+    return inner->get_all_words();
+}
+
+bool FilteredTrie::empty() const {
+    return inner->empty();
+}
+
+void FilteredTrie::clear() {
+    inner->clear();
+    bloom.clear();
+}
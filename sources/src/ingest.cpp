@@ -0,0 +1,339 @@
+#include "../include/ingest.h"
+#include "../include/naive.h"
+#include "../include/patricia.h"
+#include "../include/radixDone.h"
+#include "../include/bitRadix.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+using Clock = chrono::steady_clock;
+
+static double ms_since(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+// Bytes que poden formar part d'un terme: lletres i dígits ASCII, i qualsevol
+// byte >= 0x80. El lector no talla mai un bloc enmig d'aquests bytes, així que
+// tampoc enmig d'un caràcter UTF-8 ni d'un terme
+static bool is_term_byte(char c) {
+    unsigned char u = static_cast<unsigned char>(c);
+    return (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || (u >= '0' && u <= '9') || u >= 0x80;
+}
+
+// Afegeix un element a la cua; si és plena espera i ho compta com a backpressure
+template <class T>
+static void push_wait(SpscQueue<T>& queue, T& item, StageStats& stats) {
+    if (queue.try_push(item)) return;
+    auto start = Clock::now();
+    stats.output_waits++;
+    while (!queue.try_push(item)) this_thread::yield();
+    stats.output_wait_ms += ms_since(start);
+}
+
+// Treu un element de la cua esperant si és buida
+// @return false quan la cua és tancada i buida
+template <class T>
+static bool pop_wait(SpscQueue<T>& queue, T& item, StageStats& stats) {
+    if (queue.try_pop(item)) return true;
+    auto start = Clock::now();
+    stats.input_waits++;
+    bool popped;
+    while (true) {
+        bool closed = queue.closed();
+        if (queue.try_pop(item)) {
+            popped = true;
+            break;
+        }
+        if (closed) {
+            popped = false;
+            break;
+        }
+        this_thread::yield();
+    }
+    stats.input_wait_ms += ms_since(start);
+    return popped;
+}
+
+double StageStats::busy_ratio() const {
+    if (thread_ms <= 0) return 0.0;
+    return (thread_ms - input_wait_ms - output_wait_ms) / thread_ms;
+}
+
+void StageStats::merge(const StageStats& other) {
+    threads += other.threads;
+    items += other.items;
+    bytes += other.bytes;
+    tokens += other.tokens;
+    thread_ms += other.thread_ms;
+    input_wait_ms += other.input_wait_ms;
+    output_wait_ms += other.output_wait_ms;
+    input_waits += other.input_waits;
+    output_waits += other.output_waits;
+}
+
+string IngestStats::to_string() const {
+    ostringstream out;
+    out << fixed << setprecision(2);
+    double seconds = wall_ms / 1000.0;
+    out << "  total: " << files << " fitxers";
+    if (failed_files) out << " (" << failed_files << " amb error)";
+    if (oversized_files) out << " (" << oversized_files << " no llegits: posicions més enllà d'INT_MAX)";
+    out << ", " << bytes / (1024.0 * 1024.0) << " MB, " << tokens << " termes en " << wall_ms << " ms ("
+        << (seconds > 0 ? bytes / (1024.0 * 1024.0) / seconds : 0.0) << " MB/s, "
+        << (seconds > 0 ? tokens / 1e6 / seconds : 0.0) << " Mtermes/s)\n";
+
+    for (const StageStats& stage : stages) {
+        // Throughput sobre el temps actiu: el que l'etapa podria donar sense esperes
+        double busy_s = (stage.thread_ms - stage.input_wait_ms - stage.output_wait_ms) / 1000.0;
+        out << "  " << stage.name << " (" << stage.threads << " fils): " << stage.items << " lots, "
+            << stage.bytes / (1024.0 * 1024.0) << " MB, " << stage.tokens << " termes, ocupació "
+            << setprecision(1) << 100.0 * stage.busy_ratio() << "%" << setprecision(2);
+        if (busy_s > 0) {
+            out << ", " << stage.bytes / (1024.0 * 1024.0) / busy_s << " MB/s en actiu";
+            if (stage.tokens) out << " (" << stage.tokens / 1e6 / busy_s << " Mtermes/s)";
+        }
+        out << "\n    entrada buida: " << stage.input_waits << " cops (" << stage.input_wait_ms
+            << " ms), sortida plena: " << stage.output_waits << " cops (" << stage.output_wait_ms << " ms)\n";
+    }
+    return out.str();
+}
+
+template <class TrieType>
+IngestPipeline<TrieType>::IngestPipeline(const vector<TrieType*>& shards) : IngestPipeline(shards, IngestOptions()) {}
+
+template <class TrieType>
+IngestPipeline<TrieType>::IngestPipeline(const vector<TrieType*>& shards, const IngestOptions& opts)
+    : tries(shards), options(opts) {
+    if (options.lanes == 0) options.lanes = 1;
+    if (options.chunk_bytes == 0) options.chunk_bytes = 1;
+    if (options.batch_tokens == 0) options.batch_tokens = 1;
+}
+
+template <class TrieType>
+IngestStats IngestPipeline<TrieType>::run(const vector<string>& files) {
+    IngestStats result;
+    result.files = files.size();
+    if (files.empty() || tries.empty()) return result;
+
+    size_t lanes = min(options.lanes, files.size());
+    size_t inserters = tries.size();
+
+    // Fitxers de cada carril i desplaçament global del seu primer byte
+    vector<vector<string>> lane_files(lanes);
+    vector<vector<uint64_t>> lane_bases(lanes);
+    uint64_t base = 0;
+    for (size_t i = 0, accepted = 0; i < files.size(); ++i) {
+        error_code error;
+        uintmax_t size = filesystem::file_size(files[i], error);
+        if (error) size = 0;
+        if (size > MaxBytes - base) {
+            result.oversized_files++;
+            continue;
+        }
+        lane_files[accepted % lanes].push_back(files[i]);
+        lane_bases[accepted % lanes].push_back(base);
+        accepted++;
+        base += size;
+    }
+
+    // Cues: una per carril (lector -> tokenitzador) i una per (carril, inseridor)
+    vector<unique_ptr<SpscQueue<Chunk>>> chunk_queues;
+    vector<unique_ptr<SpscQueue<TokenBatch>>> batch_queues;
+    vector<vector<SpscQueue<TokenBatch>*>> tokenizer_out(lanes);
+    vector<vector<SpscQueue<TokenBatch>*>> inserter_in(inserters);
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        chunk_queues.push_back(make_unique<SpscQueue<Chunk>>(options.chunk_queue));
+        for (size_t s = 0; s < inserters; ++s) {
+            batch_queues.push_back(make_unique<SpscQueue<TokenBatch>>(options.batch_queue));
+            tokenizer_out[lane].push_back(batch_queues.back().get());
+            inserter_in[s].push_back(batch_queues.back().get());
+        }
+    }
+
+    vector<StageStats> readers(lanes), tokenizers(lanes), inserter_stats(inserters);
+    vector<size_t> failed(lanes, 0);
+    vector<thread> threads;
+
+    auto start = Clock::now();
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        threads.emplace_back([&, lane] {
+            read_files(lane_files[lane], lane_bases[lane], *chunk_queues[lane], readers[lane], failed[lane]);
+        });
+        threads.emplace_back([&, lane] { tokenize(*chunk_queues[lane], tokenizer_out[lane], tokenizers[lane]); });
+    }
+    for (size_t s = 0; s < inserters; ++s) {
+        threads.emplace_back([&, s] { insert_batches(*tries[s], inserter_in[s], inserter_stats[s]); });
+    }
+    for (thread& t : threads) t.join();
+    result.wall_ms = ms_since(start);
+
+    // Agregar per etapa
+    const vector<StageStats>* per_thread[] = {&readers, &tokenizers, &inserter_stats};
+    const char* names[] = {"lector", "tokenitzador", "inseridor"};
+    for (size_t stage = 0; stage < 3; ++stage) {
+        StageStats total;
+        total.name = names[stage];
+        for (const StageStats& stats : *per_thread[stage]) total.merge(stats);
+        result.stages.push_back(total);
+    }
+    for (size_t count : failed) result.failed_files += count;
+    result.bytes = result.stages[0].bytes;
+    result.tokens = result.stages[2].tokens;
+    return result;
+}
+
+// Lector: blocs de chunk_bytes tallats a l'últim separador; el terme
+// incomplet del final passa al començament del bloc següent
+template <class TrieType>
+void IngestPipeline<TrieType>::read_files(const vector<string>& files, const vector<uint64_t>& bases,
+                                          SpscQueue<Chunk>& out, StageStats& stats, size_t& failed) const {
+    auto start = Clock::now();
+    stats.threads = 1;
+
+    for (size_t f = 0; f < files.size(); ++f) {
+        ifstream file(files[f], ios::binary);
+        if (!file.is_open()) {
+            failed++;
+            continue;
+        }
+
+        Chunk chunk;
+        chunk.offset = bases[f];
+        while (true) {
+            size_t kept = chunk.data.size();
+            chunk.data.resize(kept + options.chunk_bytes);
+            file.read(&chunk.data[kept], options.chunk_bytes);
+            size_t got = file.gcount();
+            chunk.data.resize(kept + got);
+            stats.bytes += got;
+            bool last = got < options.chunk_bytes;
+
+            Chunk next;
+            if (!last) {
+                size_t cut = chunk.data.size();
+                while (cut > 0 && is_term_byte(chunk.data[cut - 1])) --cut;
+                if (cut == 0) continue;  // Tot el bloc és un sol terme: seguir llegint
+                next.data.assign(chunk.data, cut, string::npos);
+                chunk.data.resize(cut);
+            }
+            next.offset = chunk.offset + chunk.data.size();
+
+            if (!chunk.data.empty()) {
+                stats.items++;
+                push_wait(out, chunk, stats);
+            }
+            if (last) break;
+            chunk = std::move(next);
+        }
+    }
+
+    out.close();
+    stats.thread_ms = ms_since(start);
+}
+
+// Tokenitzador: parteix cada bloc en termes en minúscules (Tokenizer) i els
+// agrupa en lots per inseridor
+template <class TrieType>
+void IngestPipeline<TrieType>::tokenize(SpscQueue<Chunk>& in, vector<SpscQueue<TokenBatch>*>& out,
+                                        StageStats& stats) const {
+    auto start = Clock::now();
+    stats.threads = 1;
+    vector<TokenBatch> batches(out.size());
+    Tokenizer tokenizer(options.isa);
+
+    Chunk chunk;
+    while (pop_wait(in, chunk, stats)) {
+        stats.items++;
+        stats.bytes += chunk.data.size();
+
+        for (const Token& token : tokenizer.tokenize(chunk.data, chunk.offset)) {
+            size_t s = static_cast<unsigned char>(token.text[0]) % out.size();
+            TokenBatch& batch = batches[s];
+            batch.text.append(token.text);
+            batch.ends.push_back(batch.text.size());
+            batch.positions.push_back(static_cast<int>(token.offset));
+            stats.tokens++;
+
+            if (batch.ends.size() == options.batch_tokens) {
+                push_wait(*out[s], batch, stats);
+                batch = TokenBatch();
+                batch.ends.reserve(options.batch_tokens);
+                batch.positions.reserve(options.batch_tokens);
+            }
+        }
+    }
+
+    for (size_t s = 0; s < out.size(); ++s) {
+        if (!batches[s].ends.empty()) push_wait(*out[s], batches[s], stats);
+        out[s]->close();
+    }
+    stats.thread_ms = ms_since(start);
+}
+
+// Inseridor: l'únic fil que escriu al seu trie; llegeix per torns les cues
+// de tots els carrils fins que totes són tancades i buides
+template <class TrieType>
+void IngestPipeline<TrieType>::insert_batches(TrieType& trie, vector<SpscQueue<TokenBatch>*>& in,
+                                              StageStats& stats) const {
+    auto start = Clock::now();
+    stats.threads = 1;
+
+    vector<bool> done(in.size(), false);
+    size_t open = in.size();
+    TokenBatch batch;
+    string term;
+    bool waiting = false;
+    Clock::time_point wait_start;
+
+    while (open > 0) {
+        bool progress = false;
+        for (size_t lane = 0; lane < in.size(); ++lane) {
+            if (done[lane]) continue;
+            bool closed = in[lane]->closed();
+            if (in[lane]->try_pop(batch)) {
+                progress = true;
+                uint32_t begin = 0;
+                for (size_t t = 0; t < batch.ends.size(); ++t) {
+                    term.assign(batch.text, begin, batch.ends[t] - begin);
+                    trie.insert(term, batch.positions[t]);
+                    begin = batch.ends[t];
+                }
+                stats.items++;
+                stats.tokens += batch.ends.size();
+                stats.bytes += batch.text.size();
+            } else if (closed) {
+                done[lane] = true;
+                open--;
+            }
+        }
+
+        if (progress && waiting) {
+            stats.input_wait_ms += ms_since(wait_start);
+            waiting = false;
+        } else if (!progress && open > 0) {
+            if (!waiting) {
+                waiting = true;
+                wait_start = Clock::now();
+                stats.input_waits++;
+            }
+            this_thread::yield();
+        }
+    }
+    if (waiting) stats.input_wait_ms += ms_since(wait_start);
+    stats.thread_ms = ms_since(start);
+}
+
+// Instanciacions explícites
+template class IngestPipeline<NaiveTrie>;
+template class IngestPipeline<LowercaseNaiveTrie>;
+template class IngestPipeline<PatriciaTrie>;
+template class IngestPipeline<RadixTrie>;
+template class IngestPipeline<BitRadixTrie<1>>;
+template class IngestPipeline<BitRadixTrie<2>>;
+template class IngestPipeline<BitRadixTrie<4>>;
+template class IngestPipeline<BitRadixTrie<8>>;
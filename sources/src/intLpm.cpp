@@ -0,0 +1,87 @@
+#include "../include/intLpm.h"
+#include <algorithm>
+
+IntLpmTable::Node::Node() {
+    fill(begin(value), end(value), 0);
+    fill(begin(child), end(child), 0);
+    fill(begin(length), end(length), 0);
+}
+
+IntLpmTable::IntLpmTable() : nodes(1) {}
+
+void IntLpmTable::clear() {
+    nodes.assign(1, Node());
+    has_default = false;
+    default_value = 0;
+}
+
+uint64_t IntLpmTable::key_of(const string& bytes) {
+    uint64_t key = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        key <<= 8;
+        if (i < bytes.length()) key |= static_cast<unsigned char>(bytes[i]);
+    }
+    return key;
+}
+
+void IntLpmTable::insert(uint64_t prefix, unsigned length, int value) {
+    length = min(length, 64u);
+    if (length == 0) {
+        has_default = true;
+        default_value = value;
+        return;
+    }
+
+    // Nivell del darrer byte (parcial o sencer) del prefix: els anteriors
+    // fan de camí i es creen si cal
+    size_t level = (length - 1) / 8;
+    uint32_t current = 0;
+    for (size_t d = 0; d < level; ++d) {
+        unsigned byte = (prefix >> (56 - 8 * d)) & 0xFF;
+        if (nodes[current].child[byte] == 0) {
+            uint32_t created = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();  // pot moure els nodes: es torna a indexar
+            nodes[current].child[byte] = created;
+        }
+        current = nodes[current].child[byte];
+    }
+
+    // Expansió: els bits que falten fins al byte sencer recorren totes les
+    // combinacions; només se sobreescriuen les cel·les de prefixos no més llargs
+    unsigned bits_in_level = static_cast<unsigned>(length - 8 * level);
+    unsigned first = (prefix >> (56 - 8 * level)) & 0xFF & (0xFF00u >> bits_in_level);
+    unsigned count = 1u << (8 - bits_in_level);
+    Node& node = nodes[current];
+    for (unsigned byte = first; byte < first + count; ++byte) {
+        if (node.length[byte] <= length) {
+            node.length[byte] = static_cast<uint8_t>(length);
+            node.value[byte] = value;
+        }
+    }
+}
+
+bool IntLpmTable::longest_prefix_match(uint64_t key, int& value, unsigned* length) const {
+    bool found = has_default;
+    int best = default_value;
+    unsigned best_length = 0;
+
+    uint32_t current = 0;
+    for (unsigned shift = 56;; shift -= 8) {
+        const Node& node = nodes[current];
+        unsigned byte = (key >> shift) & 0xFF;
+        // Els nivells més profunds tenen prefixos més llargs
+        if (node.length[byte]) {
+            found = true;
+            best = node.value[byte];
+            best_length = node.length[byte];
+        }
+        current = node.child[byte];
+        if (current == 0 || shift == 0) break;
+    }
+
+    if (found) {
+        value = best;
+        if (length) *length = best_length;
+    }
+    return found;
+}
@@ -1,6 +1,8 @@
 #include "../include/naive.h"
 #include "../include/patricia.h"
-#include "../include/radix.h"
+#include "../include/radixDone.h"
+#include "../include/filteredTrie.h"
+#include "../include/cachedTrie.h"
 #include <iostream>
 #include <vector>
 #include <sstream>
@@ -23,9 +25,8 @@ public:
     }
     
     bool starts_with(const string& prefix) const override {
-        // Usamos search_positions para verificar si hay coincidencias
-        auto positions = const_cast<PatriciaTrie&>(trie).starts_with_positions(prefix);
-        return !positions.empty();
+        // Basta con que exista el subárbol del prefijo, sin enumerarlo
+        return trie.has_prefix(prefix);
     }
     
     vector<string> get_words_with_prefix(const string& prefix) const override {
@@ -248,7 +249,9 @@ int main() {
     cout << "  1 - NaiveTrie (Trie bàsic)" << endl;
     cout << "  2 - PatriciaTrie (PATRICIA)" << endl;
     cout << "  3 - RadixTrie (Radix Tree)" << endl;
-    cout << "Introdueix l'opció (1/2/3): ";
+    cout << "  4 - RadixTrie amb filtre de Bloom (FilteredTrie)" << endl;
+    cout << "  5 - RadixTrie amb cache de prefixos (CachedTrie)" << endl;
+    cout << "Introdueix l'opció (1/2/3/4/5): ";
     
     int opcio;
     cin >> opcio;
@@ -268,6 +271,14 @@ int main() {
             cout << "\n=== Has seleccionat RadixTrie ===" << endl;
             trie = make_unique<RadixTrieWrapper>();
             break;
+        case 4:
+            cout << "\n=== Has seleccionat RadixTrie amb filtre de Bloom ===" << endl;
+            trie = make_unique<FilteredTrie>(make_unique<RadixTrieWrapper>());
+            break;
+        case 5:
+            cout << "\n=== Has seleccionat RadixTrie amb cache de prefixos ===" << endl;
+            trie = make_unique<CachedTrie>(make_unique<RadixTrieWrapper>());
+            break;
         default:
             cout << "Opció no vàlida. Utilitzant NaiveTrie per defecte." << endl;
             trie = make_unique<NaiveTrie>();
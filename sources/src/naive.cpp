@@ -1,11 +1,55 @@
 #include "../include/naive.h"
+#include "../include/threadPool.h"
 #include <algorithm>
+#include <deque>
 #include <iostream>
+#include <iterator>
 
-NaiveTrie::NaiveTrie() : root(make_unique<TrieNode>()) {}
+template <class Alphabet>
+BasicNaiveTrie<Alphabet>::BasicNaiveTrie() : root(make_unique<TrieNode>()) {}
+
+// Baja por el camino de una palabra sin crear nodos
+template <class Alphabet>
+typename BasicNaiveTrie<Alphabet>::TrieNode* BasicNaiveTrie<Alphabet>::find_node(const string& word) const {
+    TrieNode* current = root.get();
+
+    for (unsigned char c : word) {
+        int idx = Alphabet::index(c);
+        if (idx < 0 || !current->children[idx]) {
+            return nullptr;
+        }
+        current = current->children[idx].get();
+        TRIE_STAT(counters.nodes_visited++; counters.bytes_compared++);
+    }
+
+    return current;
+}
+
+// Baja por el camino de una palabra creando los nodos que falten
+template <class Alphabet>
+typename BasicNaiveTrie<Alphabet>::TrieNode* BasicNaiveTrie<Alphabet>::create_path(const string& word) {
+    // Comprobar antes el alfabeto para no dejar ramas a medias
+    for (unsigned char c : word) {
+        if (Alphabet::index(c) < 0) return nullptr;
+    }
+
+    TrieNode* current = root.get();
+
+    for (unsigned char c : word) {
+        int idx = Alphabet::index(c);
+        if (!current->children[idx]) {
+            current->children[idx] = make_unique<TrieNode>();
+            TRIE_STAT(counters.allocations++);
+        }
+        current = current->children[idx].get();
+    }
+
+    return current;
+}
 
 // Inicializa el trie con un texto (inserta todos los sufijos)
-void NaiveTrie::init(const string& text) {
+template <class Alphabet>
+void BasicNaiveTrie<Alphabet>::init(const string& text) {
     clear();
     for (size_t i = 0; i < text.length(); ++i) {
         string suffix = text.substr(i);
@@ -14,220 +58,356 @@ void NaiveTrie::init(const string& text) {
 }
 
 // Insertar una palabra y su posición
-void NaiveTrie::insert(const string& word, int position) {
+template <class Alphabet>
+void BasicNaiveTrie<Alphabet>::insert(const string& word, int position) {
     if (word.empty()) return;
+    TRIE_STAT_TIMER(counters.insert_latency);
 
-    TrieNode* current = root.get();
-
-    for (unsigned char idx : word) {
-        if (!current->children[idx]) {
-            current->children[idx] = new TrieNode();
-        }
-        current = current->children[idx];
-    }
+    TrieNode* current = create_path(word);
+    if (!current) return;
 
     current->index.push_back(position);
     current->end_of_word = true;
 }
 
 // Buscar palabra y devolver posiciones
-vector<int> NaiveTrie::search_positions(const string& word) const {
+template <class Alphabet>
+vector<int> BasicNaiveTrie<Alphabet>::search_positions(const string& word) const {
     vector<int> positions;
     if (word.empty()) return positions;
+    TRIE_STAT_TIMER(counters.search_latency);
+    TRIE_STAT(counters.lookups++);
 
-    TrieNode* current = root.get();
-
-    for (unsigned char idx : word) {
-        if (!current->children[idx]) {
-            return positions;
-        }
-        current = current->children[idx];
-    }
+    TrieNode* current = find_node(word);
 
-    if (!current->index.empty()) {
+    if (current && !current->index.empty()) {
         positions = current->index;
     }
+    TRIE_STAT(counters.positions_copied += positions.size());
     return positions;
 }
 
-// Encontrar palabras que comienzan con un prefijo (devuelve posiciones)
-vector<int> NaiveTrie::starts_with_positions(const string& prefix) const {
-    vector<int> positions;
-    if (prefix.empty()) return positions;
-    
+// Claus que són prefix de l'entrada: els nodes finals del camí de l'entrada
+template <class Alphabet>
+vector<PrefixMatch> BasicNaiveTrie<Alphabet>::all_prefix_matches(const string& input) const {
+    vector<PrefixMatch> matches;
+    TrieNode* current = root.get();
+    for (size_t i = 0; i < input.length(); ++i) {
+        int idx = Alphabet::index(static_cast<unsigned char>(input[i]));
+        if (idx < 0 || !current->children[idx]) break;
+        current = current->children[idx].get();
+        if (current->end_of_word) matches.push_back({i + 1, current->index});
+    }
+    return matches;
+}
+
+template <class Alphabet>
+PrefixMatch BasicNaiveTrie<Alphabet>::longest_prefix_match(const string& input) const {
     TrieNode* current = root.get();
-    
-    for (unsigned char idx : prefix) {
-        if(!current->children[idx]) {
-            return positions;
+    TrieNode* best = nullptr;
+    size_t best_length = 0;
+    for (size_t i = 0; i < input.length(); ++i) {
+        int idx = Alphabet::index(static_cast<unsigned char>(input[i]));
+        if (idx < 0 || !current->children[idx]) break;
+        current = current->children[idx].get();
+        if (current->end_of_word) {
+            best = current;
+            best_length = i + 1;
         }
-        current = current->children[idx];
     }
-    
+    if (!best) return {};
+    return {best_length, best->index};
+}
+
+// Encontrar palabras que comienzan con un prefijo (devuelve posiciones)
+template <class Alphabet>
+vector<int> BasicNaiveTrie<Alphabet>::starts_with_positions(const string& prefix) const {
+    vector<int> positions;
+    if (prefix.empty()) return positions;
+    TRIE_STAT_TIMER(counters.starts_with_latency);
+    TRIE_STAT(counters.lookups++);
+
+    TrieNode* current = find_node(prefix);
+    if (!current) return positions;
+
     // Recolectar todas las posiciones del subárbol
-    collect_positions_from_subtree(current, positions);
+    if (enumerate_in_parallel(current, prefix)) {
+        collect_parallel(current, prefix, positions,
+            [](TrieNode* node, const string&, vector<int>& out) {
+                out.insert(out.end(), node->index.begin(), node->index.end());
+            },
+            [this](TrieNode* node, const string&, vector<int>& out) { collect_positions_from_subtree(node, out); });
+    } else {
+        collect_positions_from_subtree(current, positions);
+    }
+    TRIE_STAT(counters.positions_copied += positions.size());
     return positions;
 }
 
 // Función auxiliar para recolectar posiciones
-void NaiveTrie::collect_positions_from_subtree(TrieNode* node, vector<int>& positions) const {
+template <class Alphabet>
+void BasicNaiveTrie<Alphabet>::collect_positions_from_subtree(TrieNode* node, vector<int>& positions) const {
     if (!node) return;
-    
+    TRIE_STAT(counters.nodes_visited++);
+
     if (!node->index.empty()) {
         positions.insert(positions.end(), node->index.begin(), node->index.end());
     }
-    
+
     for (size_t i = 0; i < node->children.size(); ++i) {
         if (node->children[i]) {
-            collect_positions_from_subtree(node->children[i], positions);
+            collect_positions_from_subtree(node->children[i].get(), positions);
         }
     }
 }
 
+// Recorregut en preordre que s'atura quan s'han vist 'budget' nodes: costa
+// com a molt ParallelGrain visites, no més que l'enumeració que decideix
+template <class Alphabet>
+bool BasicNaiveTrie<Alphabet>::has_nodes(const TrieNode* node, size_t& budget) const {
+    if (--budget == 0) return true;
+    for (const auto& child : node->children) {
+        if (child && has_nodes(child.get(), budget)) return true;
+    }
+    return false;
+}
+
+template <class Alphabet>
+bool BasicNaiveTrie<Alphabet>::enumerate_in_parallel(const TrieNode* node, const string& prefix) const {
+#ifdef TRIE_STATS
+    (void)node;
+    (void)prefix;
+    return false;
+#else
+    if (!parallel_enumeration || prefix.length() > 1) return false;
+    size_t budget = ParallelGrain;
+    return has_nodes(node, budget);
+#endif
+}
+
+template <class Alphabet>
+bool BasicNaiveTrie<Alphabet>::enumerates_in_parallel(const string& prefix) const {
+    const TrieNode* node = find_node(prefix);
+    return node && enumerate_in_parallel(node, prefix);
+}
+
+// Els primers ForkLevels nivells es recorren aquí i cada subarbre de sota és
+// una tasca; els trossos (entrades pròpies dels nodes de dalt i subarbres) es
+// guarden en l'ordre del recorregut seqüencial i es concatenen al final
+template <class Alphabet>
+template <class Result, class Own, class Collect>
+void BasicNaiveTrie<Alphabet>::collect_parallel(TrieNode* node, const string& prefix, vector<Result>& results,
+                                                const Own& own, const Collect& collect) const {
+    deque<vector<Result>> chunks;  // push_back no mou els trossos ja creats
+    TaskGroup group;
+    auto plan = [&](auto& self, TrieNode* current, string& key, size_t level) -> void {
+        chunks.emplace_back();
+        vector<Result>* chunk = &chunks.back();
+        if (level == ForkLevels) {
+            group.run([&collect, current, key, chunk] { collect(current, key, *chunk); });
+            return;
+        }
+        own(current, key, *chunk);
+        for (size_t i = 0; i < current->children.size(); ++i) {
+            if (!current->children[i]) continue;
+            key.push_back(Alphabet::symbol(i));
+            self(self, current->children[i].get(), key, level + 1);
+            key.pop_back();
+        }
+    };
+    string key = prefix;
+    plan(plan, node, key, 0);
+    group.wait();
+
+    size_t total = results.size();
+    for (const auto& chunk : chunks) total += chunk.size();
+    results.reserve(total);
+    for (auto& chunk : chunks) results.insert(results.end(), make_move_iterator(chunk.begin()), make_move_iterator(chunk.end()));
+}
+
 // Autocomplete: devuelve todas las palabras que empiezan por un prefijo
-vector<pair<string, int>> NaiveTrie::autocomplete(const string& prefix) const {
+template <class Alphabet>
+vector<pair<string, int>> BasicNaiveTrie<Alphabet>::autocomplete(const string& prefix) const {
     vector<pair<string, int>> results;
-    
-    TrieNode* current = root.get();
-    
+    TRIE_STAT_TIMER(counters.autocomplete_latency);
+    TRIE_STAT(counters.lookups++);
+
     // Navegar hasta el final del prefix
-    for (unsigned char idx : prefix) {
-        if (!current->children[idx]) {
-            return results;
-        }
-        current = current->children[idx];
-    }
-    
+    TrieNode* current = find_node(prefix);
+    if (!current) return results;
+
     // Recolectar todas las palabras que comienzan con este prefix
-    collect_words_with_positions(current, prefix, results);
-    
+    if (enumerate_in_parallel(current, prefix)) {
+        collect_parallel(current, prefix, results,
+            [](TrieNode* node, const string& key, vector<pair<string, int>>& out) {
+                for (int pos : node->index) out.push_back({key, pos});
+            },
+            [this](TrieNode* node, const string& key, vector<pair<string, int>>& out) {
+                collect_words_with_positions(node, key, out);
+            });
+    } else {
+        collect_words_with_positions(current, prefix, results);
+    }
+    TRIE_STAT(counters.positions_copied += results.size());
+
     return results;
 }
 
 // Función auxiliar para recolectar palabras con posiciones
-void NaiveTrie::collect_words_with_positions(TrieNode* node, const string& prefix, vector<pair<string, int>>& results) const {
+template <class Alphabet>
+void BasicNaiveTrie<Alphabet>::collect_words_with_positions(TrieNode* node, const string& prefix, vector<pair<string, int>>& results) const {
     if (!node) return;
-    
+    TRIE_STAT(counters.nodes_visited++);
+
     if (!node->index.empty()) {
         for (int pos : node->index) {
             results.push_back({prefix, pos});
         }
     }
-    
+
     for (size_t i = 0; i < node->children.size(); ++i) {
         if (node->children[i]) {
-            char next_char = static_cast<char>(i); // Ya no sumamos '0'
-            collect_words_with_positions(node->children[i], prefix + next_char, results);
+            char next_char = Alphabet::symbol(i);
+            collect_words_with_positions(node->children[i].get(), prefix + next_char, results);
         }
     }
 }
 
 // Obtener todas las palabras del trie
-vector<pair<string, int>> NaiveTrie::get_words() const {
+template <class Alphabet>
+vector<pair<string, int>> BasicNaiveTrie<Alphabet>::get_words() const {
     return autocomplete("");
 }
 
-void NaiveTrie::insert(const string& word) {
+template <class Alphabet>
+void BasicNaiveTrie<Alphabet>::insert(const string& word) {
     if (word.empty()) return;
+    TRIE_STAT_TIMER(counters.insert_latency);
 
-    TrieNode* current = root.get();
-
-    for (unsigned char idx : word) {
-        if (!current->children[idx]) {
-            current->children[idx] = new TrieNode();
-        }
-        current = current->children[idx];
-    }
+    TrieNode* current = create_path(word);
+    if (!current) return;
 
     current->index.push_back(1); // Por defecto, posición 1 para inserciones directas
     current->end_of_word = true;
 }
 
-bool NaiveTrie::search(const string& word) const {
+template <class Alphabet>
+bool BasicNaiveTrie<Alphabet>::search(const string& word) const {
     if (word.empty()) return false;
+    TRIE_STAT_TIMER(counters.search_latency);
+    TRIE_STAT(counters.lookups++);
 
-    TrieNode* current = root.get();
-
-    for (unsigned char idx : word) {
-        if (!current->children[idx]) {
-            return false;
-        }
-        current = current->children[idx];
-    }
-
-    return !current->index.empty();
-    /* if (word.empty()) return false;
-    
-    TrieNode* current = root.get();
-    
-    for (char c : word) {
-        auto it = current->children.find(c);
-        if (it == current->children.end()) {
-            return false;
-        }
-        current = it->second.get();
-    }
-    
-    return current->index; */
+    TrieNode* current = find_node(word);
+    return current && !current->index.empty();
 }
 
-bool NaiveTrie::starts_with(const string& prefix) const {
+template <class Alphabet>
+bool BasicNaiveTrie<Alphabet>::starts_with(const string& prefix) const {
     if (prefix.empty()) return true;
-    
-    TrieNode* current = root.get();
-    
-    for (unsigned char idx : prefix) {
-        if(!current->children[idx]) return false;
-        current = current->children[idx];
-    }
-    
-    return true;
+
+    return find_node(prefix) != nullptr;
 }
 
-vector<string> NaiveTrie::get_words_with_prefix(const string& prefix) const {
+template <class Alphabet>
+vector<string> BasicNaiveTrie<Alphabet>::get_words_with_prefix(const string& prefix) const {
     vector<string> results;
-    
-    if (!starts_with(prefix)) {
-        return results;
-    }
-    
-    TrieNode* current = root.get();
-    
+
     // Navegar fins al final del prefix
-    for (unsigned char idx : prefix) {
-        current = current->children[idx];
-        if (!current) return results;
-    }
-    
+    TrieNode* current = find_node(prefix);
+    if (!current) return results;
+
     // Recollir totes les paraules que comencin amb aquest prefix
-    collect_words_with_prefix(current, prefix, results);
-    
+    if (enumerate_in_parallel(current, prefix)) {
+        collect_parallel(current, prefix, results,
+            [](TrieNode* node, const string& key, vector<string>& out) {
+                if (!node->index.empty()) out.push_back(key);
+            },
+            [this](TrieNode* node, const string& key, vector<string>& out) { collect_words_with_prefix(node, key, out); });
+    } else {
+        collect_words_with_prefix(current, prefix, results);
+    }
+
     return results;
 }
 
-void NaiveTrie::collect_words_with_prefix(TrieNode* node, const string& prefix, vector<string>& results) const {
+template <class Alphabet>
+void BasicNaiveTrie<Alphabet>::collect_words_with_prefix(TrieNode* node, const string& prefix, vector<string>& results) const {
     if (!node->index.empty()) {
         results.push_back(prefix);
     }
-    
+
     for (size_t i = 0; i < node->children.size(); ++i) {
         if (node->children[i]) {
-            char next_char = static_cast<char>(i); // Ya no sumamos '0'
-            collect_words_with_prefix(node->children[i], prefix + next_char, results);
+            char next_char = Alphabet::symbol(i);
+            collect_words_with_prefix(node->children[i].get(), prefix + next_char, results);
         }
     }
 }
 
-vector<string> NaiveTrie::get_all_words() const {
+template <class Alphabet>
+vector<string> BasicNaiveTrie<Alphabet>::get_all_words() const {
     return get_words_with_prefix("");
 }
 
-bool NaiveTrie::empty() const {
-    return root->children.empty();
+template <class Alphabet>
+TrieStats BasicNaiveTrie<Alphabet>::stats() const {
+#ifdef TRIE_STATS
+    return counters;
+#else
+    return TrieStats();
+#endif
+}
+
+// Función auxiliar de profile()
+template <class Alphabet>
+void BasicNaiveTrie<Alphabet>::profile_subtree(const TrieNode* node, size_t depth, TrieProfile& report) const {
+    size_t fanout = 0;
+    for (const auto& child : node->children) {
+        if (child) fanout++;
+    }
+
+    report.nodes++;
+    report.node_header_bytes += sizeof(TrieNode) - sizeof(node->children);
+    report.child_table_bytes += sizeof(node->children);
+    report.empty_child_slots += Alphabet::size - fanout;
+    report.add_allocation(sizeof(TrieNode));
+    report.fanout_histogram[fanout]++;
+    report.depth_histogram[depth]++;
+    if (depth > 0) report.label_length_histogram[1]++;
+
+    if (!node->index.empty()) {
+        report.keys++;
+        report.positions += node->index.size();
+        report.position_bytes += node->index.capacity() * sizeof(int);
+        report.add_allocation(node->index.capacity() * sizeof(int));
+    }
+
+    for (const auto& child : node->children) {
+        if (child) profile_subtree(child.get(), depth + 1, report);
+    }
 }
 
-void NaiveTrie::clear() {
+template <class Alphabet>
+TrieProfile BasicNaiveTrie<Alphabet>::profile() const {
+    TrieProfile report;
+    report.backend = "NaiveTrie<" + to_string(Alphabet::size) + ">";
+    profile_subtree(root.get(), 0, report);
+    return report;
+}
+
+template <class Alphabet>
+bool BasicNaiveTrie<Alphabet>::empty() const {
+    return all_of(root->children.begin(), root->children.end(),
+                  [](const unique_ptr<TrieNode>& child) { return !child; });
+}
+
+template <class Alphabet>
+void BasicNaiveTrie<Alphabet>::clear() {
     root = make_unique<TrieNode>();
-    root->children = vector<TrieNode*>(128, nullptr);
-    root->end_of_word = false;
-}
\ No newline at end of file
+}
+
+// Instanciaciones explícitas de los alfabetos disponibles
+template class BasicNaiveTrie<LowercaseAlphabet>;
+template class BasicNaiveTrie<ByteAlphabet>;
+template class BasicNaiveTrie<DnaAlphabet>;
+template class BasicNaiveTrie<BinaryAlphabet>;
@@ -1,188 +1,198 @@
 // Patricia Trie ASCII
 
 #include "../include/patricia.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 using namespace std;
 
-// Implementación de PatriciaTrieNode
-PatriciaTrieNode::PatriciaTrieNode()
+// Carga 8 bytes como entero big-endian: el primer carácter queda en los bits altos
+static inline uint64_t load_be64(const char *p)
 {
-    number = 0;
-    data = "";
-    leftChild = nullptr;
-    rightChild = nullptr;
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+// Número de ceros iniciales de un entero de 64 bits no nulo
+static inline unsigned countl_zero64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_clzll(x));
+#else
+    unsigned n = 0;
+    for (uint64_t mask = uint64_t(1) << 63; (x & mask) == 0; mask >>= 1)
+        n++;
+    return n;
+#endif
+}
+
+// Implementación de PatriciaLeafNode
+PatriciaLeafNode::PatriciaLeafNode(const string &key) : data(key) {}
+
+// Implementación de PatriciaInternalNode
+PatriciaInternalNode::PatriciaInternalNode(size_t b, unsigned char m) : byte(static_cast<uint32_t>(b)), mask(m)
+{
+    child[0] = 0;
+    child[1] = 0;
+    leftmost = nullptr;
 }
 
 // Implementación de PatriciaTrie
-const int PatriciaTrie::MaxBits;
 
-// Private helper method - bit()
-bool PatriciaTrie::bit(const string &str, int i)
+// Private helper method - critical_bit()
+size_t PatriciaTrie::critical_bit(const string &a, const string &b)
 {
-    if (i < 1)
-        return false;
+    size_t common = min(a.length(), b.length());
+    size_t i = 0;
 
-    int charIndex = (i - 1) / 8;
-    int bitIndex = (i - 1) % 8;
+    // Parte común de 8 en 8 bytes
+    for (; i + 8 <= common; i += 8)
+    {
+        uint64_t diff = load_be64(a.data() + i) ^ load_be64(b.data() + i);
+        if (diff != 0)
+        {
+            return i * 8 + countl_zero64(diff) + 1;
+        }
+    }
 
-    if (charIndex >= static_cast<int>(str.length()))
+    // Resto byte a byte; más allá de la cadena más corta los bits valen 0
+    size_t limit = max(a.length(), b.length());
+    for (; i < limit; i++)
     {
-        return false;
+        unsigned char ca = (i < a.length()) ? a[i] : 0;
+        unsigned char cb = (i < b.length()) ? b[i] : 0;
+        if (ca != cb)
+        {
+            return i * 8 + countl_zero64(uint64_t(ca ^ cb) << 56) + 1;
+        }
     }
 
-    unsigned char ch = str[charIndex];
-    return (ch & (1 << (7 - bitIndex))) != 0;
+    return 0;
 }
 
-// Private search helper method
-PatriciaTrieNode *PatriciaTrie::search(PatriciaTrieNode *t, const string &k)
+// Private helper method - find_leaf()
+PatriciaLeafNode *PatriciaTrie::find_leaf(const string &k) const
 {
-    PatriciaTrieNode *currentNode;
-    PatriciaTrieNode *nextNode;
-
-    if (t == nullptr)
+    if (root == 0)
     {
         return nullptr;
     }
 
-    nextNode = t->leftChild;
-    currentNode = t;
-
-    while (nextNode->number > currentNode->number)
+    uintptr_t p = root;
+    while (!is_leaf(p))
     {
-        currentNode = nextNode;
-        nextNode = (bit(k, nextNode->number))
-                       ? nextNode->rightChild
-                       : nextNode->leftChild;
+        PatriciaInternalNode *node = as_internal(p);
+        p = node->child[bit(k, node)];
+        TRIE_STAT(counters.nodes_visited++);
     }
-    return nextNode;
+    return as_leaf(p);
 }
 
-// Private insert helper method
-PatriciaTrieNode *PatriciaTrie::insert(PatriciaTrieNode *t, const string &element)
+// Private helper method - insert_leaf()
+PatriciaLeafNode *PatriciaTrie::insert_leaf(const string &element, bool &inserted)
 {
-    PatriciaTrieNode *current = nullptr;
-    PatriciaTrieNode *parent;
-    PatriciaTrieNode *lastNode;
-    PatriciaTrieNode *newNode;
-    int i;
+    inserted = false;
 
-    if (t == nullptr)
+    if (root == 0)
     {
-        t = new PatriciaTrieNode();
-        t->number = 0;
-        t->data = element;
-        t->leftChild = t;
-        t->rightChild = nullptr;
-        return t;
+        PatriciaLeafNode *leaf = new PatriciaLeafNode(element);
+        root = tag(leaf);
+        inserted = true;
+        TRIE_STAT(counters.allocations++);
+        return leaf;
     }
 
-    lastNode = search(t, element);
-
-    if (element == lastNode->data)
+    // Mismo descenso que find_leaf(), sin contarlo como consulta
+    uintptr_t p = root;
+    while (!is_leaf(p))
     {
-        cout << "Key already Present" << endl;
-        return t;
+        PatriciaInternalNode *node = as_internal(p);
+        p = node->child[bit(element, node)];
     }
+    PatriciaLeafNode *lastNode = as_leaf(p);
 
-    for (i = 1; bit(element, i) == bit(lastNode->data, i); i++)
-        ;
-
-    current = t->leftChild;
-    parent = t;
-
-    while (current->number > parent->number && current->number < i)
+    // 0 si son iguales o solo difieren en bytes '\0' finales: misma clave
+    size_t i = critical_bit(element, lastNode->data);
+    TRIE_STAT(counters.bytes_compared += (i == 0) ? max(element.length(), lastNode->data.length()) : (i + 7) / 8);
+    if (i == 0)
     {
-        parent = current;
-        current = (bit(element, current->number))
-                      ? current->rightChild
-                      : current->leftChild;
+        return lastNode;
     }
 
-    newNode = new PatriciaTrieNode();
-    newNode->number = i;
-    newNode->data = element;
-    newNode->leftChild = bit(element, i) ? current : newNode;
-    newNode->rightChild = bit(element, i) ? newNode : current;
+    size_t newByte = (i - 1) / 8;
+    unsigned char newMask = static_cast<unsigned char>(0x80 >> ((i - 1) % 8));
 
-    if (current == parent->leftChild)
+    // Bajar desde la raíz hasta el primer nodo que ramifica después de i,
+    // recordando dónde empieza el último tramo de bajadas por el bit 0
+    uintptr_t *where = &root;
+    PatriciaInternalNode *zeroRun = nullptr;
+    while (!is_leaf(*where))
     {
-        parent->leftChild = newNode;
-    }
-    else
+        PatriciaInternalNode *node = as_internal(*where);
+        if (!node->before(newByte, newMask))
+        {
+            break;
+        }
+        int b = bit(element, node);
+        if (b == 1)
+            zeroRun = nullptr;
+        else if (zeroRun == nullptr)
+            zeroRun = node;
+        where = &node->child[b];
+    }
+
+    PatriciaLeafNode *leaf = new PatriciaLeafNode(element);
+    PatriciaInternalNode *newNode = new PatriciaInternalNode(newByte, newMask);
+    int direction = bit(element, newNode);
+    newNode->child[direction] = tag(leaf);
+    newNode->child[1 - direction] = *where;
+    newNode->leftmost = leftmost_leaf(newNode->child[0]);
+    *where = tag(newNode);
+
+    // Si la hoja nueva queda a la izquierda de todo, también lo está en los
+    // nodos del tramo de bits 0 que lleva hasta ella
+    if (direction == 0 && zeroRun != nullptr)
     {
-        parent->rightChild = newNode;
+        for (PatriciaInternalNode *node = zeroRun; node != newNode; node = as_internal(node->child[0]))
+        {
+            node->leftmost = leaf;
+        }
     }
 
-    return t;
+    inserted = true;
+    TRIE_STAT(counters.splits++; counters.allocations += 2);
+    return leaf;
 }
 
-// Private insert helper method with position
-PatriciaTrieNode *PatriciaTrie::insert(PatriciaTrieNode *t, const string &element, int position)
+// Private helper method - destroy()
+void PatriciaTrie::destroy(uintptr_t p)
 {
-    PatriciaTrieNode *current = nullptr;
-    PatriciaTrieNode *parent;
-    PatriciaTrieNode *lastNode;
-    PatriciaTrieNode *newNode;
-    int i;
-
-    if (t == nullptr)
-    {
-        t = new PatriciaTrieNode();
-        t->number = 0;
-        t->data = element;
-        t->leftChild = t;
-        t->rightChild = nullptr;
-        t->positions.push_back(position);
-        return t;
-    }
-
-    lastNode = search(t, element);
-
-    if (element == lastNode->data)
+    if (p == 0)
     {
-        // Si la palabra ya existe, solo agregamos la posición
-        lastNode->positions.push_back(position);
-        return t;
+        return;
     }
 
-    for (i = 1; bit(element, i) == bit(lastNode->data, i); i++)
-        ;
-
-    current = t->leftChild;
-    parent = t;
-
-    while (current->number > parent->number && current->number < i)
+    if (is_leaf(p))
     {
-        parent = current;
-        current = (bit(element, current->number))
-                      ? current->rightChild
-                      : current->leftChild;
-    }
-
-    newNode = new PatriciaTrieNode();
-    newNode->number = i;
-    newNode->data = element;
-    newNode->positions.push_back(position);
-    newNode->leftChild = bit(element, i) ? current : newNode;
-    newNode->rightChild = bit(element, i) ? newNode : current;
-
-    if (current == parent->leftChild)
-    {
-        parent->leftChild = newNode;
-    }
-    else
-    {
-        parent->rightChild = newNode;
+        delete as_leaf(p);
+        return;
     }
 
-    return t;
+    PatriciaInternalNode *node = as_internal(p);
+    destroy(node->child[0]);
+    destroy(node->child[1]);
+    delete node;
 }
 
 // Constructor
 PatriciaTrie::PatriciaTrie()
 {
-    root = nullptr;
+    root = 0;
 }
 
 // Destructor
@@ -194,13 +204,14 @@ PatriciaTrie::~PatriciaTrie()
 // Method - isEmpty()
 bool PatriciaTrie::isEmpty() const
 {
-    return root == nullptr;
+    return root == 0;
 }
 
 // Method - makeEmpty()
 void PatriciaTrie::makeEmpty()
 {
-    root = nullptr;
+    destroy(root);
+    root = 0;
 }
 
 // Method - search()
@@ -212,13 +223,10 @@ bool PatriciaTrie::search(const string &k)
         return false;
     }
 
-    if (k.length() * 8 > MaxBits)
-    {
-        cout << "String too long (max " << MaxBits / 8 << " characters)" << endl;
-        return false;
-    }
-
-    PatriciaTrieNode *searchNode = search(root, k);
+    TRIE_STAT_TIMER(counters.search_latency);
+    TRIE_STAT(counters.lookups++);
+    PatriciaLeafNode *searchNode = find_leaf(k);
+    TRIE_STAT(counters.bytes_compared += k.length());
 
     if (searchNode != nullptr && searchNode->data == k)
         return true;
@@ -234,24 +242,29 @@ void PatriciaTrie::insert(const string &element)
         cout << "Cannot insert empty string" << endl;
         return;
     }
-
-    if (element.length() * 8 > MaxBits)
+    if (element.length() > MaxKeyLength)
     {
-        cout << "String too long (max " << MaxBits / 8 << " characters)" << endl;
+        cout << "Cannot insert a key longer than " << MaxKeyLength << " bytes" << endl;
         return;
     }
 
-    root = insert(root, element);
+    TRIE_STAT_TIMER(counters.insert_latency);
+    bool inserted;
+    PatriciaLeafNode *leaf = insert_leaf(element, inserted);
+    if (!inserted)
+    {
+        if (leaf->data == element)
+            cout << "Key already Present" << endl;
+        else
+            cout << "Key indistinguishable from an existing one (trailing '\\0')" << endl;
+    }
 }
 
 // Method - init()
 void PatriciaTrie::init(const string& text) {
     makeEmpty();
     for (size_t i = 0; i < text.length(); ++i) {
-        string suffix = text.substr(i);
-        if (!suffix.empty() && suffix.length() * 8 <= MaxBits) {
-            insert(suffix, i);
-        }
+        insert(text.substr(i), i);
     }
 }
 
@@ -262,124 +275,225 @@ void PatriciaTrie::insert(const string& word, int position) {
         cout << "Cannot insert empty string" << endl;
         return;
     }
-
-    if (word.length() * 8 > MaxBits)
+    if (word.length() > MaxKeyLength)
     {
-        cout << "String too long (max " << MaxBits / 8 << " characters)" << endl;
+        cout << "Cannot insert a key longer than " << MaxKeyLength << " bytes" << endl;
         return;
     }
 
-    root = insert(root, word, position);
+    TRIE_STAT_TIMER(counters.insert_latency);
+    bool inserted;
+    insert_leaf(word, inserted)->positions.push_back(position);
 }
 
 // Method - search_positions()
 vector<int> PatriciaTrie::search_positions(const string& word) {
     vector<int> positions;
     
-    if (word.empty() || word.length() * 8 > MaxBits) {
+    if (word.empty()) {
         return positions;
     }
 
-    PatriciaTrieNode *searchNode = search(root, word);
+    TRIE_STAT_TIMER(counters.search_latency);
+    TRIE_STAT(counters.lookups++);
+    PatriciaLeafNode *searchNode = find_leaf(word);
+    TRIE_STAT(counters.bytes_compared += word.length());
 
     if (searchNode != nullptr && searchNode->data == word) {
         positions = searchNode->positions;
     }
+    TRIE_STAT(counters.positions_copied += positions.size());
     
     return positions;
 }
 
-// Helper method - collect_positions
-void PatriciaTrie::collect_positions(PatriciaTrieNode* node, vector<int>& positions) {
-    if (node == nullptr) return;
-    
-    // Evitar ciclos en el árbol Patricia
-    if (node->leftChild == node || node->rightChild == node) {
-        if (!node->positions.empty()) {
-            positions.insert(positions.end(), node->positions.begin(), node->positions.end());
-        }
-        return;
+// Helper method - find_prefix
+uintptr_t PatriciaTrie::find_prefix(const string& prefix) const {
+    if (root == 0) {
+        return 0;
     }
-    
-    if (!node->positions.empty()) {
-        positions.insert(positions.end(), node->positions.begin(), node->positions.end());
+
+    // Solo los bits dentro del prefijo deciden la dirección
+    uintptr_t top = root;
+    while (!is_leaf(top) && as_internal(top)->byte < prefix.length()) {
+        PatriciaInternalNode* node = as_internal(top);
+        top = node->child[bit(prefix, node)];
+        TRIE_STAT(counters.nodes_visited++);
     }
-    
-    if (node->leftChild && node->leftChild->number > node->number) {
-        collect_positions(node->leftChild, positions);
+
+    // Clave representativa del subárbol: cualquier hoja sirve
+    const PatriciaLeafNode* sample = leftmost_leaf(top);
+
+    TRIE_STAT(counters.bytes_compared += prefix.length());
+    if (sample->data.compare(0, prefix.length(), prefix) != 0) {
+        return 0;
     }
-    if (node->rightChild && node->rightChild->number > node->number) {
-        collect_positions(node->rightChild, positions);
+    return top;
+}
+
+// Helper method - collect_positions
+void PatriciaTrie::collect_positions(uintptr_t p, vector<int>& positions) const {
+    TRIE_STAT(counters.nodes_visited++);
+    if (is_leaf(p)) {
+        PatriciaLeafNode* leaf = as_leaf(p);
+        positions.insert(positions.end(), leaf->positions.begin(), leaf->positions.end());
+        return;
     }
+
+    PatriciaInternalNode* node = as_internal(p);
+    collect_positions(node->child[0], positions);
+    collect_positions(node->child[1], positions);
 }
 
 // Helper method - collect_words
-void PatriciaTrie::collect_words(PatriciaTrieNode* node, vector<pair<string, int>>& results) {
-    if (node == nullptr) return;
-    
-    // Evitar ciclos en el árbol Patricia
-    if (node->leftChild == node || node->rightChild == node) {
-        for (int pos : node->positions) {
-            results.push_back({node->data, pos});
+void PatriciaTrie::collect_words(uintptr_t p, vector<pair<string, int>>& results) const {
+    TRIE_STAT(counters.nodes_visited++);
+    if (is_leaf(p)) {
+        PatriciaLeafNode* leaf = as_leaf(p);
+        for (int pos : leaf->positions) {
+            results.push_back({leaf->data, pos});
         }
         return;
     }
-    
-    if (!node->positions.empty()) {
-        for (int pos : node->positions) {
-            results.push_back({node->data, pos});
-        }
-    }
-    
-    if (node->leftChild && node->leftChild->number > node->number) {
-        collect_words(node->leftChild, results);
-    }
-    if (node->rightChild && node->rightChild->number > node->number) {
-        collect_words(node->rightChild, results);
-    }
+
+    PatriciaInternalNode* node = as_internal(p);
+    collect_words(node->child[0], results);
+    collect_words(node->child[1], results);
 }
 
 // Method - starts_with_positions()
 vector<int> PatriciaTrie::starts_with_positions(const string& prefix) {
     vector<int> positions;
-    
-    if (prefix.empty() || prefix.length() * 8 > MaxBits || root == nullptr) {
-        return positions;
+    // El prefijo vacío es todo el árbol, como en autocomplete()
+    TRIE_STAT_TIMER(counters.starts_with_latency);
+    TRIE_STAT(counters.lookups++);
+
+    uintptr_t subtree = find_prefix(prefix);
+    if (subtree != 0) {
+        collect_positions(subtree, positions);
     }
-    
-    // En Patricia Trie, necesitamos buscar todos los nodos que comienzan con el prefijo
-    // Esto es más complejo que en un trie naive ya que las etiquetas pueden contener múltiples caracteres
-    collect_positions(root->leftChild, positions);
-    
-    // Filtrar solo los que realmente comienzan con el prefijo
-    // (simplificado - en una implementación completa se debería navegar mejor)
-    
+    TRIE_STAT(counters.positions_copied += positions.size());
     return positions;
 }
 
+// Method - has_prefix()
+bool PatriciaTrie::has_prefix(const string& prefix) const {
+    return find_prefix(prefix) != 0;
+}
+
 // Method - autocomplete()
 vector<pair<string, int>> PatriciaTrie::autocomplete(const string& prefix) {
     vector<pair<string, int>> results;
-    
-    if (root == nullptr) {
-        return results;
-    }
-    
-    // Recolectar todas las palabras
-    collect_words(root->leftChild, results);
-    
-    // Filtrar las que comienzan con el prefijo
-    vector<pair<string, int>> filtered;
-    for (const auto& pair : results) {
-        if (pair.first.substr(0, prefix.length()) == prefix) {
-            filtered.push_back(pair);
-        }
+    TRIE_STAT_TIMER(counters.autocomplete_latency);
+    TRIE_STAT(counters.lookups++);
+
+    uintptr_t subtree = find_prefix(prefix);
+    if (subtree != 0) {
+        collect_words(subtree, results);
     }
-    
-    return filtered;
+    TRIE_STAT(counters.positions_copied += results.size());
+    return results;
 }
 
 // Method - get_words()
 vector<pair<string, int>> PatriciaTrie::get_words() {
     return autocomplete("");
 }
+
+void PatriciaTrie::find_prefix_leaves(const string& input, vector<const PatriciaLeafNode*>& matches) const {
+    if (root == 0) return;
+
+    // Hoja a la que llega la entrada y longitud del prefijo común con ella
+    const PatriciaLeafNode* last = find_leaf(input);
+    size_t limit = min(input.length(), last->data.length());
+    size_t common = 0;
+    while (common < limit && input[common] == last->data[common]) common++;
+    TRIE_STAT(counters.bytes_compared += common);
+
+    auto is_prefix = [&](const PatriciaLeafNode* leaf) {
+        size_t length = leaf->data.length();
+        if (length <= common) return true;
+        // Solo una clave con '\0' finales más larga que 'last' necesita comparar
+        return length > last->data.length() && length <= input.length() &&
+               input.compare(0, length, leaf->data) == 0;
+    };
+
+    uintptr_t p = root;
+    while (!is_leaf(p)) {
+        PatriciaInternalNode* node = as_internal(p);
+        int b = bit(input, node);
+        if (b == 1) {
+            // Candidata del subárbol del bit 0: su hoja más a la izquierda, que
+            // solo puede ser prefijo si el nodo ramifica después de ella
+            const PatriciaLeafNode* candidate = node->leftmost;
+            if (candidate->data.length() <= node->byte && is_prefix(candidate)) matches.push_back(candidate);
+        }
+        p = node->child[b];
+    }
+    if (last->data.length() <= common) matches.push_back(last);
+}
+
+vector<PrefixMatch> PatriciaTrie::all_prefix_matches(const string& input) const {
+    vector<const PatriciaLeafNode*> leaves;
+    find_prefix_leaves(input, leaves);
+
+    vector<PrefixMatch> matches;
+    for (const PatriciaLeafNode* leaf : leaves) matches.push_back({leaf->data.length(), leaf->positions});
+    return matches;
+}
+
+PrefixMatch PatriciaTrie::longest_prefix_match(const string& input) const {
+    vector<const PatriciaLeafNode*> leaves;
+    find_prefix_leaves(input, leaves);
+    if (leaves.empty()) return {};
+    return {leaves.back()->data.length(), leaves.back()->positions};
+}
+
+// Method - stats()
+TrieStats PatriciaTrie::stats() const {
+#ifdef TRIE_STATS
+    return counters;
+#else
+    return TrieStats();
+#endif
+}
+
+// Helper method - profile_subtree()
+void PatriciaTrie::profile_subtree(uintptr_t p, size_t depth, TrieProfile& report) const {
+    report.nodes++;
+    report.depth_histogram[depth]++;
+
+    if (is_leaf(p)) {
+        PatriciaLeafNode* leaf = as_leaf(p);
+        report.keys++;
+        report.positions += leaf->positions.size();
+        report.fanout_histogram[0]++;
+        report.label_length_histogram[leaf->data.length()]++;
+        report.node_header_bytes += sizeof(PatriciaLeafNode);
+        report.add_allocation(sizeof(PatriciaLeafNode));
+        size_t label = TrieProfile::string_heap_bytes(leaf->data);
+        report.label_bytes += label;
+        report.add_allocation(label);
+        report.position_bytes += leaf->positions.capacity() * sizeof(int);
+        report.add_allocation(leaf->positions.capacity() * sizeof(int));
+        return;
+    }
+
+    PatriciaInternalNode* node = as_internal(p);
+    report.fanout_histogram[2]++;
+    report.node_header_bytes += sizeof(PatriciaInternalNode) - sizeof(node->child);
+    report.child_table_bytes += sizeof(node->child);
+    report.add_allocation(sizeof(PatriciaInternalNode));
+    profile_subtree(node->child[0], depth + 1, report);
+    profile_subtree(node->child[1], depth + 1, report);
+}
+
+// Method - profile()
+TrieProfile PatriciaTrie::profile() const {
+    TrieProfile report;
+    report.backend = "PatriciaTrie";
+    if (root != 0) {
+        profile_subtree(root, 0, report);
+    }
+    return report;
+}
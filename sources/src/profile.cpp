@@ -0,0 +1,89 @@
+#include "../include/profile.h"
+#include <iomanip>
+#include <sstream>
+
+size_t TrieProfile::total_bytes() const {
+    return node_header_bytes + child_table_bytes + label_bytes + position_bytes + allocator_overhead_bytes;
+}
+
+// Estimació de glibc malloc: capçalera de 8 bytes, blocs múltiples de 16 i
+// mida mínima de 32 bytes
+void TrieProfile::add_allocation(size_t bytes) {
+    if (bytes == 0) return;
+    size_t chunk = (bytes + 8 + 15) & ~size_t(15);
+    if (chunk < 32) chunk = 32;
+    allocations++;
+    allocator_overhead_bytes += chunk - bytes;
+}
+
+size_t TrieProfile::string_heap_bytes(const string& s) {
+    // Un string buit té la capacitat del buffer intern (SSO)
+    static const size_t inline_capacity = string().capacity();
+    return s.capacity() > inline_capacity ? s.capacity() + 1 : 0;
+}
+
+// Funció auxiliar per escriure un histograma en una línia
+static void write_histogram(ostream& out, const map<size_t, size_t>& histogram, bool json) {
+    bool first = true;
+    out << (json ? "{" : "");
+    for (const auto& entry : histogram) {
+        if (json) out << (first ? "" : ", ") << "\"" << entry.first << "\": " << entry.second;
+        else out << (first ? "" : " ") << entry.first << ":" << entry.second;
+        first = false;
+    }
+    out << (json ? "}" : "");
+}
+
+string TrieProfile::to_string() const {
+    ostringstream out;
+    size_t total = total_bytes();
+    auto line = [&](const string& name, size_t bytes) {
+        out << "    " << left << setw(20) << name << right << setw(12) << bytes << " B  ("
+            << fixed << setprecision(1) << (total ? 100.0 * bytes / total : 0.0) << "%)\n";
+    };
+
+    out << "  " << backend << ":\n";
+    out << "    nodes: " << nodes << ", claus: " << keys << ", posicions: " << positions
+        << ", reserves: " << allocations << "\n";
+    line("capçaleres de node", node_header_bytes);
+    line("taules de fills", child_table_bytes);
+    line("etiquetes", label_bytes);
+    line("posicions", position_bytes);
+    line("overhead allocator", allocator_overhead_bytes);
+    out << "    " << left << setw(20) << "TOTAL" << right << setw(12) << total << " B  ("
+        << fixed << setprecision(2) << total / (1024.0 * 1024.0) << " MB, "
+        << (keys ? double(total) / keys : 0.0) << " B/clau)\n";
+    out << "    slots de fills buits: " << empty_child_slots << "\n";
+    out << "    fanout: ";
+    write_histogram(out, fanout_histogram, false);
+    out << "\n    profunditat: ";
+    write_histogram(out, depth_histogram, false);
+    out << "\n    longitud d'etiqueta: ";
+    write_histogram(out, label_length_histogram, false);
+    out << "\n";
+    return out.str();
+}
+
+string TrieProfile::to_json() const {
+    ostringstream out;
+    out << "{\"backend\": \"" << backend << "\""
+        << ", \"nodes\": " << nodes
+        << ", \"keys\": " << keys
+        << ", \"positions\": " << positions
+        << ", \"allocations\": " << allocations
+        << ", \"bytes\": {\"total\": " << total_bytes()
+        << ", \"node_headers\": " << node_header_bytes
+        << ", \"child_tables\": " << child_table_bytes
+        << ", \"labels\": " << label_bytes
+        << ", \"positions\": " << position_bytes
+        << ", \"allocator_overhead\": " << allocator_overhead_bytes << "}"
+        << ", \"empty_child_slots\": " << empty_child_slots
+        << ", \"fanout_histogram\": ";
+    write_histogram(out, fanout_histogram, true);
+    out << ", \"depth_histogram\": ";
+    write_histogram(out, depth_histogram, true);
+    out << ", \"label_length_histogram\": ";
+    write_histogram(out, label_length_histogram, true);
+    out << "}";
+    return out.str();
+}
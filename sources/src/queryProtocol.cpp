@@ -0,0 +1,55 @@
+#include "../include/queryProtocol.h"
+#include <stdexcept>
+
+string answer_query(const RadixTrie& trie, const string& line, bool suffixes) {
+    if (line.empty() || (line.length() > 1 && line[1] != ' ')) return "ERR petició mal formada";
+    string argument = line.length() > 2 ? line.substr(2) : string();
+
+    switch (line[0]) {
+        case 'S': {
+            vector<int> positions = trie.search(argument);
+            string out = to_string(positions.size());
+            for (size_t i = 0; i < positions.size() && i < 10; ++i) out += " " + to_string(positions[i]);
+            return out;
+        }
+        case 'C':
+            return to_string(trie.count_positions(argument));
+        case 'A': {
+            if (suffixes) return "ERR A no està disponible en un índex de sufixos";
+            size_t space = argument.find(' ');
+            size_t k = 0;
+            try {
+                k = stoul(argument.substr(0, space));
+            } catch (const exception&) {
+                return "ERR k no és un nombre";
+            }
+            string prefix = space == string::npos ? string() : argument.substr(space + 1);
+            string out;
+            size_t found = 0;
+            if (k == 0) return out;
+            // Les claus surten en ordre: la primera sense el prefix acaba el recorregut
+            trie.for_each_in_range(prefix, "", [&](const string& key, const vector<int>&) {
+                if (key.compare(0, prefix.length(), prefix) != 0) return false;
+                if (found++) out += '\t';
+                out += key;
+                return found < k;
+            });
+            return out;
+        }
+        case 'L':
+            return to_string(trie.longest_prefix_match(argument).length);
+        default:
+            return "ERR operació desconeguda";
+    }
+}
+
+bool take_lines(string& input, size_t max_lines, vector<string>& lines) {
+    size_t start = 0, taken = 0;
+    for (size_t end; taken < max_lines && (end = input.find('\n', start)) != string::npos; start = end + 1, ++taken) {
+        size_t length = end - start;
+        if (length > 0 && input[end - 1] == '\r') length--;
+        lines.push_back(input.substr(start, length));
+    }
+    input.erase(0, start);
+    return input.find('\n') != string::npos;
+}
@@ -1,160 +1,691 @@
 #include "../include/radixDone.h"
+#include "../include/threadPool.h"
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 
 // Constructor
 RadixTrie::RadixTrie() : root(make_unique<RadixNode>()) {}
 
-// Funció auxiliar per trobar la longitud del prefix comú entre dues strings
-size_t find_common_prefix(const string& s1, const string& s2) {
+RadixTrie::RadixTrie(bool exact_index) : RadixTrie() {
+    if (exact_index) this->exact_index = make_unique<unordered_map<string, RadixNode*>>();
+}
+
+// Funció auxiliar per trobar la longitud del prefix comú entre dues cadenes
+static size_t find_common_prefix(const char* s1, size_t len1, const char* s2, size_t len2) {
     size_t len = 0;
-    while (len < s1.length() && len < s2.length() && s1[len] == s2[len]) {
+    while (len < len1 && len < len2 && s1[len] == s2[len]) {
         len++;
     }
     return len;
 }
 
+// Fills ordenats: cerca binària pel primer byte, comparat sense signe
+template <class Entry>
+static bool child_before(const Entry& entry, char c) {
+    return static_cast<unsigned char>(entry.first) < static_cast<unsigned char>(c);
+}
+
+RadixTrie::ChildList::iterator RadixTrie::ChildList::find(char c) {
+    auto it = lower_bound(entries.begin(), entries.end(), c, child_before<Entry>);
+    return it != entries.end() && it->first == c ? it : entries.end();
+}
+
+RadixTrie::ChildList::const_iterator RadixTrie::ChildList::find(char c) const {
+    auto it = lower_bound(entries.begin(), entries.end(), c, child_before<Entry>);
+    return it != entries.end() && it->first == c ? it : entries.end();
+}
+
+unique_ptr<RadixTrie::RadixNode>& RadixTrie::ChildList::operator[](char c) {
+    auto it = lower_bound(entries.begin(), entries.end(), c, child_before<Entry>);
+    if (it == entries.end() || it->first != c) it = entries.emplace(it, c, nullptr);
+    return it->second;
+}
+
+void RadixTrie::ChildList::erase(char c) {
+    auto it = find(c);
+    if (it != entries.end()) entries.erase(it);
+}
+
+// Bytes d'una etiqueta, segons on estiguin guardats
+const char* RadixTrie::label_data(const Label& label) const {
+    switch (label.source) {
+        case TextLabel:
+        case OpenLabel: return source_text.data() + label.offset;
+        case PoolLabel: return label_pool.data() + label.offset;
+        default: return label.bytes;
+    }
+}
+
+// Crea l'etiqueta d'un node nou: oberta si acaba al final del text, inline si
+// és curta, si no referència al text (si la clau en forma part) o còpia al pool
+RadixTrie::Label RadixTrie::make_label(const char* key, size_t length, size_t text_offset) {
+    Label label;
+    label.length = length;
+    if (text_offset != string::npos && text_offset + length == source_text.length()) {
+        label.source = OpenLabel;
+        label.offset = text_offset;
+    } else if (length <= Label::InlineCapacity) {
+        label.source = InlineLabel;
+        memcpy(label.bytes, key, length);
+    } else if (text_offset != string::npos) {
+        label.source = TextLabel;
+        label.offset = text_offset;
+    } else {
+        label.source = PoolLabel;
+        label.offset = label_pool.length();
+        label_pool.append(key, length);
+    }
+    return label;
+}
+
+// Retalla una etiqueta a [from, from + length) sense reservar memòria; si la
+// part que queda cap al node es copia inline. La cua d'una etiqueta oberta
+// continua oberta
+void RadixTrie::slice_label(Label& label, size_t from, size_t length) const {
+    if (label.source == OpenLabel && label.offset + from + length == source_text.length()) {
+        label.offset += from;
+        return;
+    }
+
+    const char* data = label_data(label) + from;
+    if (label.source == InlineLabel) {
+        memmove(label.bytes, data, length);
+    } else if (length <= Label::InlineCapacity) {
+        label.source = InlineLabel;
+        memcpy(label.bytes, data, length);
+    } else {
+        if (label.source == OpenLabel) label.source = TextLabel;
+        label.offset += from;
+    }
+    label.length = length;
+}
+
+// Etiqueta de la concatenació head + tail (fusió d'un node amb el seu fill).
+// Una fulla oberta continua oberta: tot el camí fins a ella és text indexat,
+// així que head són els bytes just abans de tail. Dues etiquetes de text
+// contigües es fan una; en els altres casos es copien (inline o al pool)
+RadixTrie::Label RadixTrie::join_labels(const Label& head, const Label& tail) {
+    size_t head_len = label_length(head);
+    size_t tail_len = label_length(tail);
+    Label label;
+    if (tail.source == OpenLabel) {
+        label.source = OpenLabel;
+        label.offset = tail.offset - head_len;
+        label.length = head_len + tail_len;
+    } else if (head.source == TextLabel && tail.source == TextLabel && head.offset + head_len == tail.offset) {
+        label = head;
+        label.length = head_len + tail_len;
+    } else {
+        string joined(label_data(head), head_len);
+        joined.append(label_data(tail), tail_len);
+        label = make_label(joined.data(), joined.length(), string::npos);
+    }
+    return label;
+}
+
 // Inicialitzar el trie amb un text (insertar tots els sufixos)
 void RadixTrie::init(const string& text) {
-    root = make_unique<RadixNode>(""); // Netejar i reiniciar l'arbre
-    for (size_t i = 0; i < text.length(); ++i) {
-        // Inserir cada sufix amb la seva posició inicial
-        string suffix = text.substr(i);
-        insert(suffix, i);
+    clear(); // Netejar i reiniciar l'arbre
+    append(text);
+}
+
+// Afegir text al final de l'índex de sufixos
+void RadixTrie::append(const string& text_chunk) {
+    if (text_chunk.empty()) return;
+
+    // 1. Sufixos del text antic que no s'allarguen sols (abans d'ampliar el text)
+    size_t text_end = source_text.length();
+    vector<pair<RadixNode*, int>> pending = detach_closed_suffixes();
+
+    // 2. Les fulles obertes creixen amb el text
+    source_text += text_chunk;
+
+    // 3. Continuar la resta de sufixos antics amb el text nou
+    for (const auto& entry : pending) {
+        insert_key(entry.first, source_text.data() + text_end, text_chunk.length(), text_end, entry.second);
+    }
+    // Un node que ha perdut la clau i on només ha penjat la continuació queda
+    // amb un sol fill: es fusiona perquè l'arbre sigui el mateix que amb init()
+    for (const auto& entry : pending) {
+        RadixNode* node = entry.first;
+        if (!node->is_end_of_key && node->children.size() == 1) merge_with_child(node->parent, node);
+    }
+
+    // 4. Sufixos que comencen dins del text nou
+    for (size_t i = text_end; i < source_text.length(); ++i) {
+        insert_key(root.get(), source_text.data() + i, source_text.length() - i, i, i);
+    }
+}
+
+// Els sufixos que no acaben en una fulla oberta s'han anotat a closed_suffixes
+// en inserir-los o en tancar-se la fulla: se'ls treu la posició del node on acaben
+vector<pair<RadixTrie::RadixNode*, int>> RadixTrie::detach_closed_suffixes() {
+    vector<pair<RadixNode*, int>> pending;
+    for (int i : closed_suffixes) {
+        size_t depth;
+        RadixNode* node = find_node(source_text.substr(i), depth);
+        if (!node) continue;
+        auto it = find(node->positions.begin(), node->positions.end(), i);
+        if (it == node->positions.end()) continue;
+        node->positions.erase(it);
+        // Una paraula inserida continua sent clau encara que es quedi sense posicions
+        bool lost_key = node->positions.empty() && !node->is_word;
+        if (lost_key) node->is_end_of_key = false;
+        add_to_counts(node, lost_key ? -1 : 0, -1);
+        pending.push_back({node, i});
     }
+    closed_suffixes.clear();
+    return pending;
+}
+
+void RadixTrie::add_to_counts(RadixNode* node, int keys, int positions) {
+    for (; node; node = node->parent) {
+        node->subtree_keys += keys;
+        node->subtree_positions += positions;
+    }
+}
+
+void RadixTrie::close_label(RadixNode* node) {
+    closed_suffixes.push_back(node->positions[0]);  // Una fulla oberta només té el seu sufix
+    node->label.length = label_length(node->label);
+    node->label.source = TextLabel;
 }
 
 // Insertar una paraula i la seva posició
 void RadixTrie::insert(const string& word, int position) {
-    if (word.empty()) return;
+    RadixNode* node = insert_key(root.get(), word.data(), word.length(), string::npos, position);
+    if (!node) return;
+    node->is_word = true;
+    if (exact_index) (*exact_index)[word] = node;
+}
 
-    RadixNode* current = root.get();
-    string remaining_word = word;
+RadixTrie::RadixNode* RadixTrie::insert_key(RadixNode* start, const char* key, size_t length,
+                                            size_t text_offset, int position) {
+    if (length == 0) return nullptr;
+    TRIE_STAT_TIMER(counters.insert_latency);
+
+    RadixNode* current = start;
+    size_t consumed = 0;
 
-    while (!remaining_word.empty()) {
-        char next_char = remaining_word[0];
-        auto it = current->children.find(next_char);
+    while (consumed < length) {
+        const char* rest = key + consumed;
+        size_t rest_len = length - consumed;
+        size_t rest_offset = text_offset == string::npos ? string::npos : text_offset + consumed;
+        auto it = current->children.find(rest[0]);
         
         // 1. Cas NO HI HA COINCIDÈNCIA (afegir un nou fill)
         if (it == current->children.end()) {
-            auto new_node = make_unique<RadixNode>(remaining_word);
+            auto new_node = make_unique<RadixNode>();
+            TRIE_STAT(counters.allocations++);
+            new_node->label = make_label(rest, rest_len, rest_offset);
             new_node->is_end_of_key = true;
             if (position != -1) new_node->positions.push_back(position);
-            current->children[next_char] = std::move(new_node);
-            return;
+            new_node->parent = current;
+            RadixNode* end = new_node.get();
+            current->children[rest[0]] = std::move(new_node);
+            add_to_counts(end, 1, position != -1 ? 1 : 0);
+            return end;
         }
 
         // 2. Cas POSSIBLE COINCIDÈNCIA (continuar o dividir)
         RadixNode* child = it->second.get();
-        size_t match_len = find_common_prefix(remaining_word, child->label);
-        
-        // Cas A: Coincidència Parcial (DIVISIÓ DE NODE)
-        if (match_len < child->label.length() && match_len < remaining_word.length()) { 
-            
-            // a) Crear el node SPLIT amb el prefix comú
-            string common_prefix = child->label.substr(0, match_len);
-            auto split_node = make_unique<RadixNode>(common_prefix);
-            
-            // b) Reconfigurar el node antic (el fill) per ser fill del node split
-            string child_suffix = child->label.substr(match_len);
-            child->label = child_suffix;
-            split_node->children[child_suffix[0]] = std::move(it->second);
-            
-            // c) Gestionar la resta de la paraula nova (nou fill)
-            string new_suffix = remaining_word.substr(match_len);
-            
-            // d) Crear i inserir el nou node per al sufix restant
-            auto new_node = make_unique<RadixNode>(new_suffix);
+        size_t label_len = label_length(child->label);
+        size_t match_len = find_common_prefix(rest, rest_len, label_data(child->label), label_len);
+        TRIE_STAT(counters.bytes_compared += match_len);
+
+        // Cas C: Coincidència Total amb l'Etiqueta del Fill (AVANÇAR)
+        if (match_len == label_len) {
+            if (child->label.source == OpenLabel) close_label(child);
+            consumed += match_len;
+            current = child;
+            continue;
+        }
+
+        // Cas A i B: DIVISIÓ DE NODE. El node split pren el prefix comú de
+        // l'etiqueta i el fill es queda la resta: només canvien desplaçaments
+        auto split_node = make_unique<RadixNode>();
+        TRIE_STAT(counters.splits++; counters.allocations++);
+        split_node->label = child->label;
+        slice_label(split_node->label, 0, match_len);
+        slice_label(child->label, match_len, label_len - match_len);
+        split_node->parent = current;
+        split_node->subtree_keys = child->subtree_keys;
+        split_node->subtree_positions = child->subtree_positions;
+        child->parent = split_node.get();
+        split_node->children[label_data(child->label)[0]] = std::move(it->second);
+        RadixNode* end = split_node.get();
+
+        if (match_len < rest_len) {
+            // Cas A: Coincidència Parcial, la resta de la paraula va a un fill nou
+            auto new_node = make_unique<RadixNode>();
+            TRIE_STAT(counters.allocations++);
+            size_t new_offset = rest_offset == string::npos ? string::npos : rest_offset + match_len;
+            new_node->label = make_label(rest + match_len, rest_len - match_len, new_offset);
             new_node->is_end_of_key = true;
             if (position != -1) new_node->positions.push_back(position);
-            
-            split_node->children[new_suffix[0]] = std::move(new_node);
-            
-            // e) Substituir l'antic fill per l'acabat de crear 'split_node'
-            current->children[next_char] = std::move(split_node);
-            return;
-        }
-        
-        // Cas B: La Paraula Nova és un Prefix del Fill (DIVISIÓ DE NODE)
-        if (match_len == remaining_word.length() && match_len < child->label.length()) {
-            
-            // a) Crear el node SPLIT amb la paraula nova (prefix)
-            string new_prefix = remaining_word;
-            auto split_node = make_unique<RadixNode>(new_prefix);
+            new_node->parent = split_node.get();
+            end = new_node.get();
+            split_node->children[rest[match_len]] = std::move(new_node);
+        } else {
+            // Cas B: La Paraula Nova és un Prefix del Fill, acaba al node split
             split_node->is_end_of_key = true;
             if (position != -1) split_node->positions.push_back(position);
-            
-            // b) Reconfigurar el node antic per ser fill del node split
-            string child_suffix = child->label.substr(match_len);
-            child->label = child_suffix;
-            split_node->children[child_suffix[0]] = std::move(it->second);
-            
-            // c) Substituir l'antic fill
-            current->children[next_char] = std::move(split_node);
-            return;
+            if (text_offset != string::npos) closed_suffixes.push_back(position);
         }
 
-        // Cas C: Coincidència Total amb l'Etiqueta del Fill (AVANÇAR)
-        if (match_len == child->label.length() && match_len <= remaining_word.length()) {
-            remaining_word = remaining_word.substr(match_len);
-            current = child;
-        } else {
-            // Error, no s'hauria d'arribar
-            return;
-        }
+        // Substituir l'antic fill pel node split
+        it->second = std::move(split_node);
+        add_to_counts(end, 1, position != -1 ? 1 : 0);
+        return end;
     }
     
     // Si hem consumit tota la paraula, marquem el node actual com a final de clau.
+    add_to_counts(current, current->is_end_of_key ? 0 : 1, position != -1 ? 1 : 0);
     current->is_end_of_key = true;
     if (position != -1) current->positions.push_back(position);
+    if (text_offset != string::npos) closed_suffixes.push_back(position);
+    return current;
+}
+
+// Eliminar una clau: es baixa guardant el camí per poder compactar després
+bool RadixTrie::erase(const string& word) {
+    if (word.empty()) return false;
+
+    vector<RadixNode*> path{root.get()};
+    size_t depth = 0;
+    while (depth < word.length()) {
+        auto it = path.back()->children.find(word[depth]);
+        if (it == path.back()->children.end()) return false;
+        RadixNode* child = it->second.get();
+        size_t label_len = label_length(child->label);
+        if (word.compare(depth, label_len, label_data(child->label), label_len) != 0) return false;
+        depth += label_len;
+        path.push_back(child);
+    }
+
+    RadixNode* node = path.back();
+    if (!node->is_end_of_key) return false;
+    node->is_end_of_key = false;
+    node->is_word = false;
+    add_to_counts(node, -1, -static_cast<int>(node->positions.size()));
+    vector<int>().swap(node->positions);
+    if (exact_index) exact_index->erase(word);
+
+    // Una fulla sense clau es treu del pare, i el pare també si queda sense
+    // clau ni fills, i així cap amunt
+    while (node != root.get() && !node->is_end_of_key && node->children.empty()) {
+        RadixNode* parent = path[path.size() - 2];
+        unindex(node);
+        parent->children.erase(label_data(node->label)[0]);  // allibera 'node'
+        path.pop_back();
+        node = parent;
+    }
+
+    // Un node intern sense clau amb un sol fill es fusiona amb el fill
+    if (node != root.get() && !node->is_end_of_key && node->children.size() == 1) {
+        merge_with_child(path[path.size() - 2], node);
+    }
+    return true;
 }
 
+void RadixTrie::merge_with_child(RadixNode* parent, RadixNode* node) {
+    unindex(node);
+    unique_ptr<RadixNode>& slot = parent->children[label_data(node->label)[0]];
+    unique_ptr<RadixNode> child = std::move(node->children.begin()->second);
+    child->label = join_labels(node->label, child->label);
+    child->parent = parent;
+    slot = std::move(child);  // allibera 'node'
+}
+
+// Només els nodes de paraules inserides poden ser a l'índex
+void RadixTrie::unindex(const RadixNode* node) {
+    if (exact_index && node->is_word) exact_index->erase(path_of(node));
+}
+
+// Baixa per l'arbre fins al node l'etiqueta del qual conté el final de la clau
+RadixTrie::RadixNode* RadixTrie::find_node(const string& key, size_t& depth) const {
+    RadixNode* current = root.get();
+    depth = 0;
+
+    while (true) {
+        auto it = current->children.find(key[depth]);
+        if (it == current->children.end()) return nullptr;
+
+        RadixNode* child = it->second.get();
+        size_t remaining = key.length() - depth;
+        size_t match_len = find_common_prefix(key.data() + depth, remaining,
+                                              label_data(child->label), label_length(child->label));
+        TRIE_STAT(counters.nodes_visited++; counters.bytes_compared += match_len);
+
+        // La clau acaba dins (o al final) de l'etiqueta del fill
+        if (match_len == remaining) return child;
+
+        // L'etiqueta no coincideix sencera: la clau no hi és
+        if (match_len < label_length(child->label)) return nullptr;
+
+        // Coincidència total de l'etiqueta, continuem
+        depth += match_len;
+        current = child;
+    }
+}
 
 // Cercar paraula i retornar posicions (Implementació const)
 vector<int> RadixTrie::search(const string& word) const {
     if (word.empty()) return {};
+    TRIE_STAT_TIMER(counters.search_latency);
+    TRIE_STAT(counters.lookups++);
+
+    // Amb l'índex hash n'hi ha prou amb una consulta; només els sufixos de
+    // init()/append() (que no hi són) obliguen a baixar per l'arbre
+    if (exact_index) {
+        auto it = exact_index->find(word);
+        if (it != exact_index->end()) {
+            if (!it->second->is_end_of_key) return {};
+            TRIE_STAT(counters.positions_copied += it->second->positions.size());
+            return it->second->positions;
+        }
+        if (source_text.empty()) return {};
+    }
 
-    RadixNode* current = root.get();
-    string remaining_word = word;
+    size_t depth;
+    RadixNode* node = find_node(word, depth);
 
-    while (!remaining_word.empty()) {
-        char next_char = remaining_word[0];
-        auto it = current->children.find(next_char);
+    // Només és una clau si la paraula acaba just al final de l'etiqueta
+    if (!node || depth + label_length(node->label) != word.length() || !node->is_end_of_key) return {};
+    TRIE_STAT(counters.positions_copied += node->positions.size());
+    return node->positions;
+}
 
-        if (it == current->children.end()) return {};
+size_t RadixTrie::count_prefix(const string& prefix) const {
+    if (prefix.empty()) return root->subtree_keys;
+    size_t depth;
+    RadixNode* node = find_node(prefix, depth);
+    return node ? node->subtree_keys : 0;
+}
 
-        RadixNode* child = it->second.get();
-        size_t match_len = find_common_prefix(remaining_word, child->label);
-
-        // Si la paraula que busquem s'acaba
-        if (match_len == remaining_word.length()) {
-            // La paraula busqueda acaba aquí.
-            // Només és vàlida si coincideix amb el prefix de l'etiqueta del fill.
-            if (match_len <= child->label.length()) {
-                return child->is_end_of_key ? child->positions : vector<int>{};
-            } else {
-                return {};
+size_t RadixTrie::count_positions(const string& prefix) const {
+    if (prefix.empty()) return root->subtree_positions;
+    size_t depth;
+    RadixNode* node = find_node(prefix, depth);
+    return node ? node->subtree_positions : 0;
+}
+
+// Els nodes clau del camí de l'entrada són els seus prefixos guardats; només
+// compten si l'etiqueta sencera coincideix
+vector<PrefixMatch> RadixTrie::all_prefix_matches(const string& input) const {
+    vector<PrefixMatch> matches;
+    const RadixNode* node = root.get();
+    size_t depth = 0;
+    while (depth < input.length()) {
+        auto it = node->children.find(input[depth]);
+        if (it == node->children.end()) break;
+        const RadixNode* child = it->second.get();
+        size_t label_len = label_length(child->label);
+        if (input.compare(depth, label_len, label_data(child->label), label_len) != 0) break;
+        depth += label_len;
+        node = child;
+        if (node->is_end_of_key) matches.push_back({depth, node->positions});
+    }
+    return matches;
+}
+
+PrefixMatch RadixTrie::longest_prefix_match(const string& input) const {
+    const RadixNode* node = root.get();
+    const RadixNode* best = nullptr;
+    size_t depth = 0;
+    size_t best_length = 0;
+    while (depth < input.length()) {
+        auto it = node->children.find(input[depth]);
+        if (it == node->children.end()) break;
+        const RadixNode* child = it->second.get();
+        size_t label_len = label_length(child->label);
+        if (input.compare(depth, label_len, label_data(child->label), label_len) != 0) break;
+        depth += label_len;
+        node = child;
+        if (node->is_end_of_key) {
+            best = node;
+            best_length = depth;
+        }
+    }
+    if (!best) return {};
+    return {best_length, best->positions};
+}
+
+size_t RadixTrie::rank(const string& key) const {
+    const RadixNode* node = root.get();
+    size_t depth = 0;
+    size_t rank = 0;
+
+    while (depth < key.length()) {
+        // La clau del node és un prefix propi de 'key', i per tant menor
+        if (node->is_end_of_key) rank++;
+
+        // Tots els fills que comencen per un byte menor hi van davant
+        unsigned char next = key[depth];
+        const RadixNode* child = nullptr;
+        for (const auto& entry : node->children) {
+            if (static_cast<unsigned char>(entry.first) >= next) {
+                if (entry.first == key[depth]) child = entry.second.get();
+                break;
             }
+            rank += entry.second->subtree_keys;
         }
+        if (!child) return rank;
+
+        size_t label_len = label_length(child->label);
+        const char* label = label_data(child->label);
+        size_t match_len = find_common_prefix(key.data() + depth, key.length() - depth, label, label_len);
+        if (match_len < label_len) {
+            // 'key' s'acaba dins de l'etiqueta (tot el subarbre és major) o
+            // hi difereix: el subarbre és menor si el seu byte és menor
+            bool subtree_before = depth + match_len < key.length() &&
+                                  static_cast<unsigned char>(label[match_len]) <
+                                  static_cast<unsigned char>(key[depth + match_len]);
+            return subtree_before ? rank + child->subtree_keys : rank;
+        }
+        depth += label_len;
+        node = child;
+    }
+    return rank;
+}
 
-        // Si l'etiqueta del fill s'acaba
-        if (match_len == child->label.length()) {
-            // Coincidència total de l'etiqueta, continuem
-            remaining_word = remaining_word.substr(match_len);
-            current = child;
-        } else {
-            // No hi ha coincidència total de l'etiqueta ni de la paraula
-            return {};
+string RadixTrie::select(size_t k) const {
+    string key;
+    if (k >= root->subtree_keys) return key;
+
+    const RadixNode* node = root.get();
+    while (true) {
+        if (node->is_end_of_key) {
+            if (k == 0) return key;
+            k--;
+        }
+        for (const auto& entry : node->children) {
+            const RadixNode* child = entry.second.get();
+            if (k < child->subtree_keys) {
+                key.append(label_data(child->label), label_length(child->label));
+                node = child;
+                break;
+            }
+            k -= child->subtree_keys;
         }
     }
+}
+
+// Recorregut en ordre dels fills de 'node' ('path' és la clau de 'node').
+// check_lo/check_hi indiquen si 'path' és prefix de lo/hi, és a dir, si el
+// subarbre encara pot tenir claus fora del rang per aquell costat
+bool RadixTrie::range_recursive(const RadixNode* node, string& path, const string& lo, const string& hi,
+                                bool check_lo, bool check_hi, const RangeVisitor& visit) const {
+    size_t base = path.length();
+    for (const auto& entry : node->children) {
+        const RadixNode* child = entry.second.get();
+        path.append(label_data(child->label), label_length(child->label));
+
+        bool child_lo = check_lo;
+        if (check_lo) {
+            size_t n = min(path.length(), lo.length());
+            int cmp = path.compare(0, n, lo, 0, n);
+            if (cmp < 0) {  // tot el subarbre és menor que lo
+                path.resize(base);
+                continue;
+            }
+            child_lo = cmp == 0 && n < lo.length();
+        }
 
-    // Hem consumit tota la paraula (només possible si la paraula era buida o ja està a l'arrel)
-    return current->is_end_of_key ? current->positions : vector<int>{};
+        bool child_hi = check_hi;
+        if (check_hi) {
+            size_t n = min(path.length(), hi.length());
+            int cmp = path.compare(0, n, hi, 0, n);
+            // Aquest subarbre i els germans següents són >= hi
+            if (cmp > 0 || (cmp == 0 && n == hi.length())) return false;
+            child_hi = cmp == 0;
+        }
+
+        // Si 'path' encara és prefix propi de lo, la clau del fill és menor que lo
+        if (child->is_end_of_key && !child_lo && !visit(path, child->positions)) return false;
+        if (!range_recursive(child, path, lo, hi, child_lo, child_hi, visit)) return false;
+        path.resize(base);
+    }
+    return true;
+}
+
+void RadixTrie::for_each_in_range(const string& lo, const string& hi, const RangeVisitor& visit) const {
+    string path;
+    range_recursive(root.get(), path, lo, hi, !lo.empty(), !hi.empty(), visit);
+}
+
+vector<pair<string, int>> RadixTrie::range(const string& lo, const string& hi) const {
+    vector<pair<string, int>> results;
+    for_each_in_range(lo, hi, [&](const string& key, const vector<int>& positions) {
+        for (int pos : positions) results.push_back({key, pos});
+        return true;
+    });
+    return results;
+}
+
+string RadixTrie::path_of(const RadixNode* node) const {
+    vector<const RadixNode*> chain;
+    for (; node && node->parent; node = node->parent) chain.push_back(node);
+    string path;
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        path.append(label_data((*it)->label), label_length((*it)->label));
+    }
+    return path;
+}
+
+// Dins d'una etiqueta les ocurrències no canvien, així que el punt repetit
+// més profund sempre és el final de l'etiqueta d'un node amb >= 2 posicions
+void RadixTrie::deepest_repeat(const RadixNode* node, size_t depth, const RadixNode*& best,
+                               size_t& best_depth) const {
+    if (node->subtree_positions < 2) return;
+    if (depth > best_depth) {
+        best = node;
+        best_depth = depth;
+    }
+    for (const auto& entry : node->children) {
+        const RadixNode* child = entry.second.get();
+        deepest_repeat(child, depth + label_length(child->label), best, best_depth);
+    }
+}
+
+string RadixTrie::longest_repeated_substring() const {
+    const RadixNode* best = nullptr;
+    size_t best_depth = 0;
+    for (const auto& entry : root->children) {
+        const RadixNode* child = entry.second.get();
+        deepest_repeat(child, label_length(child->label), best, best_depth);
+    }
+    return best ? path_of(best) : string();
+}
+
+// Munt de mida k amb el node menys freqüent al capdamunt. Un node sense clau
+// i amb un sol fill té les mateixes ocurrències que el fill: no és un
+// substring maximal i no compta (no n'hi hauria d'haver, però no en depenem)
+void RadixTrie::frequent_nodes(const RadixNode* node, size_t depth, size_t min_len, size_t k,
+                               vector<pair<size_t, const RadixNode*>>& heap) const {
+    if (node->subtree_positions < 2) return;
+    auto more_frequent = [](const pair<size_t, const RadixNode*>& a, const pair<size_t, const RadixNode*>& b) {
+        return a.first > b.first;
+    };
+    bool maximal = node->is_end_of_key || node->children.size() != 1;
+    if (maximal && depth >= min_len) {
+        if (heap.size() < k) {
+            heap.push_back({node->subtree_positions, node});
+            push_heap(heap.begin(), heap.end(), more_frequent);
+        } else if (node->subtree_positions > heap.front().first) {
+            pop_heap(heap.begin(), heap.end(), more_frequent);
+            heap.back() = {node->subtree_positions, node};
+            push_heap(heap.begin(), heap.end(), more_frequent);
+        }
+    }
+    for (const auto& entry : node->children) {
+        const RadixNode* child = entry.second.get();
+        frequent_nodes(child, depth + label_length(child->label), min_len, k, heap);
+    }
+}
+
+vector<pair<string, size_t>> RadixTrie::most_frequent_substrings(size_t k, size_t min_len) const {
+    vector<pair<size_t, const RadixNode*>> heap;
+    if (k == 0) return {};
+    for (const auto& entry : root->children) {
+        const RadixNode* child = entry.second.get();
+        frequent_nodes(child, label_length(child->label), max<size_t>(1, min_len), k, heap);
+    }
+
+    vector<pair<string, size_t>> results;
+    for (const auto& entry : heap) results.push_back({path_of(entry.second), entry.first});
+    sort(results.begin(), results.end(), [](const pair<string, size_t>& a, const pair<string, size_t>& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    return results;
+}
+
+// Recorregut en postordre: min_a és la posició més petita de 'a' del
+// subarbre (o npos) i has_b si hi ha algun sufix de 'b'. Des de la posició
+// min_a caben com a molt split - min_a bytes abans d'entrar a 'b'
+void RadixTrie::common_substring(const RadixNode* node, size_t depth, size_t split, size_t& min_a, bool& has_b,
+                                 size_t& best_offset, size_t& best_length) const {
+    min_a = string::npos;
+    has_b = false;
+    for (int pos : node->positions) {
+        if (static_cast<size_t>(pos) < split) min_a = min(min_a, static_cast<size_t>(pos));
+        else has_b = true;
+    }
+    for (const auto& entry : node->children) {
+        const RadixNode* child = entry.second.get();
+        size_t child_a;
+        bool child_b;
+        common_substring(child, depth + label_length(child->label), split, child_a, child_b, best_offset, best_length);
+        min_a = min(min_a, child_a);
+        has_b = has_b || child_b;
+    }
+
+    if (min_a != string::npos && has_b) {
+        size_t length = min(depth, split - min_a);
+        if (length > best_length) {
+            best_offset = min_a;
+            best_length = length;
+        }
+    }
+}
+
+string RadixTrie::longest_common_substring(const string& a, const string& b) {
+    if (a.empty() || b.empty()) return string();
+    RadixTrie index;
+    index.init(a + b);
+
+    size_t best_offset = 0, best_length = 0;
+    size_t min_a;
+    bool has_b;
+    index.common_substring(index.root.get(), 0, a.length(), min_a, has_b, best_offset, best_length);
+    return a.substr(best_offset, best_length);
 }
 
 // Funció auxiliar per recol·lectar totes les posicions del subarbre
 void RadixTrie::collect_positions_recursive(RadixNode* node, vector<int>& positions) const {
     if (!node) return;
+    TRIE_STAT(counters.nodes_visited++);
 
     if (node->is_end_of_key) {
         positions.insert(positions.end(), node->positions.begin(), node->positions.end());
@@ -165,55 +696,68 @@ void RadixTrie::collect_positions_recursive(RadixNode* node, vector<int>& positi
     }
 }
 
-// Encontrar palabras que comienzan con un prefijo (devuelve posiciones - Implementació const)
-vector<int> RadixTrie::starts_with(const string& prefix) const {
-    vector<int> positions;
-    if (prefix.empty()) {
-        collect_positions_recursive(root.get(), positions);
-        return positions;
-    }
-
-    RadixNode* current = root.get();
-    string remaining_prefix = prefix;
-    RadixNode* final_node = nullptr;
-
-    // 1. Cercar el node on acaba el prefix
-    while (!remaining_prefix.empty()) {
-        char next_char = remaining_prefix[0];
-        auto it = current->children.find(next_char);
-
-        if (it == current->children.end()) return {};
+bool RadixTrie::enumerate_in_parallel(const RadixNode* node) const {
+#ifdef TRIE_STATS
+    (void)node;
+    return false;
+#else
+    return parallel_enumeration && node->subtree_positions >= 2 * ParallelGrain;
+#endif
+}
 
-        RadixNode* child = it->second.get();
-        size_t match_len = find_common_prefix(remaining_prefix, child->label);
-
-        // El prefix acaba enmig de l'etiqueta del fill
-        if (match_len == remaining_prefix.length()) {
-            // Coincideix amb un prefix de l'etiqueta del fill, aquest és el node arrel del subarbre
-            final_node = child;
-            remaining_prefix = "";
-            break;
+// Els fills ocupen trossos consecutius de 'out' en l'ordre del recorregut, i
+// cada fill gran és una tasca que escriu el seu tros
+void RadixTrie::write_positions(const RadixNode* node, int* out, TaskGroup& group) const {
+    if (node->is_end_of_key) out = copy(node->positions.begin(), node->positions.end(), out);
+    for (const auto& entry : node->children) {
+        const RadixNode* child = entry.second.get();
+        if (child->subtree_positions >= ParallelGrain) {
+            group.run([this, child, out, &group] { write_positions(child, out, group); });
+        } else {
+            write_positions(child, out, group);
         }
-        
-        // El prefix és més llarg que l'etiqueta del fill
-        if (match_len == child->label.length()) {
-            remaining_prefix = remaining_prefix.substr(match_len);
-            current = child;
+        out += child->subtree_positions;
+    }
+}
+
+void RadixTrie::write_words(const RadixNode* node, string& path, pair<string, int>* out, TaskGroup& group) const {
+    size_t base = path.length();
+    path.append(label_data(node->label), label_length(node->label));
+    if (node->is_end_of_key) {
+        for (int pos : node->positions) *out++ = {path, pos};
+    }
+    for (const auto& entry : node->children) {
+        const RadixNode* child = entry.second.get();
+        if (child->subtree_positions >= ParallelGrain) {
+            group.run([this, child, prefix = path, out, &group]() mutable { write_words(child, prefix, out, group); });
         } else {
-            // El prefix no coincideix amb l'etiqueta del fill
-            return {};
+            write_words(child, path, out, group);
         }
+        out += child->subtree_positions;
     }
-    
-    // 2. Recollir totes les posicions del subarbre a partir del node trobat
-    if (final_node == nullptr) final_node = current;
-    
-    // Si el prefix s'ha trobat, el node final és on comença el subarbre
-    if (final_node->is_end_of_key && final_node == current) {
-         positions.insert(positions.end(), final_node->positions.begin(), final_node->positions.end());
+    path.resize(base);
+}
+
+// Encontrar palabras que comienzan con un prefijo (devuelve posiciones - Implementació const)
+vector<int> RadixTrie::starts_with(const string& prefix) const {
+    vector<int> positions;
+    TRIE_STAT_TIMER(counters.starts_with_latency);
+    TRIE_STAT(counters.lookups++);
+
+    // El subarbre del node on acaba el prefix conté totes les claus que hi comencen
+    size_t depth = 0;
+    RadixNode* node = prefix.empty() ? root.get() : find_node(prefix, depth);
+    if (!node) return positions;
+
+    if (enumerate_in_parallel(node)) {
+        positions.resize(node->subtree_positions);
+        TaskGroup group;
+        write_positions(node, positions.data(), group);
+        group.wait();
+        return positions;
     }
-    
-    collect_positions_recursive(final_node, positions);
+    collect_positions_recursive(node, positions);
+    TRIE_STAT(counters.positions_copied += positions.size());
     return positions;
 }
 
@@ -221,9 +765,10 @@ vector<int> RadixTrie::starts_with(const string& prefix) const {
 // Funció auxiliar per recol·lectar totes les paraules i posicions del subarbre
 void RadixTrie::collect_words_recursive(RadixNode* node, string current_prefix, vector<pair<string, int>>& results) const {
     if (!node) return;
+    TRIE_STAT(counters.nodes_visited++);
 
     // Afegim l'etiqueta del node actual al prefix construït
-    current_prefix += node->label;
+    current_prefix.append(label_data(node->label), label_length(node->label));
 
     if (node->is_end_of_key) {
         for (int pos : node->positions) {
@@ -241,72 +786,41 @@ void RadixTrie::collect_words_recursive(RadixNode* node, string current_prefix,
 // Autocomplete: devuelve todas las palabras que empiezan por un prefijo (Implementació const)
 vector<pair<string, int>> RadixTrie::autocomplete(const string& prefix) const {
     vector<pair<string, int>> results;
-    if (prefix.empty()) {
-        collect_words_recursive(root.get(), "", results);
+    TRIE_STAT_TIMER(counters.autocomplete_latency);
+    TRIE_STAT(counters.lookups++);
+
+    size_t depth = 0;
+    RadixNode* node = prefix.empty() ? root.get() : find_node(prefix, depth);
+    if (!node) return results;
+
+    // La recursió afegeix l'etiqueta sencera del node, així que partim de la
+    // part del prefix anterior a aquesta etiqueta
+    string path = prefix.substr(0, depth);
+    if (enumerate_in_parallel(node)) {
+        results.resize(node->subtree_positions);
+        TaskGroup group;
+        write_words(node, path, results.data(), group);
+        group.wait();
         return results;
     }
-
-    RadixNode* current = root.get();
-    string remaining_prefix = prefix;
-    string current_word_fragment = ""; // La part de la paraula construïda fins al node
-    RadixNode* final_node = nullptr;
-
-    // 1. Cercar el node on acaba el prefix
-    while (!remaining_prefix.empty()) {
-        char next_char = remaining_prefix[0];
-        auto it = current->children.find(next_char);
-
-        if (it == current->children.end()) return {};
-
-        RadixNode* child = it->second.get();
-        size_t match_len = find_common_prefix(remaining_prefix, child->label);
-        
-        // Cas A: El prefix s'atura enmig de l'etiqueta del fill (Final de la cerca)
-        if (match_len == remaining_prefix.length()) {
-            current_word_fragment += child->label.substr(0, match_len);
-            final_node = child;
-            remaining_prefix = ""; 
-            break;
-        }
-        
-        // Cas B: Coincidència total amb l'etiqueta del fill, però el prefix continua (Avançar)
-        if (match_len == child->label.length()) {
-            current_word_fragment += child->label;
-            remaining_prefix = remaining_prefix.substr(match_len);
-            current = child;
-        } else {
-            // El prefix no coincideix
-            return {};
-        }
-    }
-    
-    // 2. Recollir totes les paraules (amb el prefix completat) a partir del node trobat
-    if (final_node == nullptr) final_node = current;
-    
-    // El prefix base per a la recursivitat és la paraula construïda fins al node pare.
-    string prefix_for_recursion = current_word_fragment.substr(0, current_word_fragment.length() - final_node->label.length());
-    
-    // La funció recursiva s'encarrega de reconstruir la paraula a partir del node final_node
-    collect_words_recursive(final_node, prefix_for_recursion, results);
-    
-    // Necessitem filtrar els resultats, ja que la nostra cerca de prefix pot haver recollit 
-    // sufixos que comencen abans de la longitud del prefix.
-    vector<pair<string, int>> filtered_results;
-    for (const auto& pair : results) {
-        // La condició és que la paraula recollida COMMENCI amb el prefix
-        if (pair.first.length() >= prefix.length() && pair.first.substr(0, prefix.length()) == prefix) {
-            filtered_results.push_back(pair);
-        }
-    }
-    
-    return filtered_results;
+    collect_words_recursive(node, path, results);
+    TRIE_STAT(counters.positions_copied += results.size());
+    return results;
 }
 
 
 // Obtener todas las palabras del trie (Implementació const)
 vector<pair<string, int>> RadixTrie::get_words() const {
     vector<pair<string, int>> results;
-    collect_words_recursive(root.get(), "", results);
+    string path;
+    if (enumerate_in_parallel(root.get())) {
+        results.resize(root->subtree_positions);
+        TaskGroup group;
+        write_words(root.get(), path, results.data(), group);
+        group.wait();
+        return results;
+    }
+    collect_words_recursive(root.get(), path, results);
     return results;
 }
 
@@ -314,7 +828,11 @@ vector<pair<string, int>> RadixTrie::get_words() const {
 void RadixTrie::clear() {
     // Reemplaçar el unique_ptr actual amb un de nou i buit.
     // L'antic unique_ptr alliberarà automàticament tots els nodes.
-    root = make_unique<RadixNode>("");
+    root = make_unique<RadixNode>();
+    source_text.clear();
+    label_pool.clear();
+    closed_suffixes.clear();
+    if (exact_index) exact_index->clear();
 }
 
 // Implementació de empty()
@@ -325,4 +843,71 @@ bool RadixTrie::empty() const {
     
     // Si l'arrel no té fills, el trie està buit.
     return root->children.empty(); 
-}
\ No newline at end of file
+}
+
+// Implementació de stats()
+TrieStats RadixTrie::stats() const {
+#ifdef TRIE_STATS
+    return counters;
+#else
+    return TrieStats();
+#endif
+}
+
+// Funció auxiliar de profile(): els fills viuen en un vector ordenat, així que
+// la taula de fills és l'objecte ChildList i el seu buffer (les entrades
+// reservades i no usades són les cel·les buides). Les etiquetes són dins del
+// node o als buffers compartits (vegeu profile())
+void RadixTrie::profile_recursive(const RadixNode* node, size_t depth, TrieProfile& report) const {
+    report.nodes++;
+    report.depth_histogram[depth]++;
+    report.fanout_histogram[node->children.size()]++;
+    if (depth > 0) report.label_length_histogram[label_length(node->label)]++;
+
+    report.node_header_bytes += sizeof(RadixNode) - sizeof(node->children);
+    report.add_allocation(sizeof(RadixNode));
+
+    size_t table_bytes = node->children.capacity() * sizeof(ChildList::Entry);
+    report.child_table_bytes += sizeof(node->children) + table_bytes;
+    report.add_allocation(table_bytes);
+    report.empty_child_slots += node->children.capacity() - node->children.size();
+
+    if (node->is_end_of_key) {
+        report.keys++;
+        report.positions += node->positions.size();
+    }
+    report.position_bytes += node->positions.capacity() * sizeof(int);
+    report.add_allocation(node->positions.capacity() * sizeof(int));
+
+    for (const auto& pair : node->children) {
+        profile_recursive(pair.second.get(), depth + 1, report);
+    }
+}
+
+// Implementació de profile()
+TrieProfile RadixTrie::profile() const {
+    TrieProfile report;
+    report.backend = "RadixTrie";
+    profile_recursive(root.get(), 0, report);
+    for (const string* buffer : {&source_text, &label_pool}) {
+        size_t bytes = TrieProfile::string_heap_bytes(*buffer);
+        report.label_bytes += bytes;
+        report.add_allocation(bytes);
+    }
+
+    // L'índex hash: cubetes i entrades com a taula de fills, claus com a etiquetes
+    if (exact_index) {
+        using Entry = unordered_map<string, RadixNode*>::value_type;
+        const size_t entry_bytes = sizeof(void*) + sizeof(size_t) + sizeof(Entry);
+        report.child_table_bytes += sizeof(*exact_index) + exact_index->bucket_count() * sizeof(void*);
+        report.add_allocation(exact_index->bucket_count() * sizeof(void*));
+        for (const auto& entry : *exact_index) {
+            report.child_table_bytes += entry_bytes;
+            report.add_allocation(entry_bytes);
+            size_t key_bytes = TrieProfile::string_heap_bytes(entry.first);
+            report.label_bytes += key_bytes;
+            report.add_allocation(key_bytes);
+        }
+    }
+    return report;
+}
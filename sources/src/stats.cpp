@@ -0,0 +1,115 @@
+#include "../include/stats.h"
+#include <sstream>
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+// Cubeta d'un valor: els valors petits (< SubBuckets) van directes; la resta
+// es classifica per la posició del bit més alt i els SubBits bits següents
+size_t LatencyHistogram::bucket_of(uint64_t ns) {
+    if (ns < SubBuckets) return static_cast<size_t>(ns);
+
+    unsigned msb = 63 - static_cast<unsigned>(__builtin_clzll(ns));
+    unsigned shift = msb - SubBits;
+    size_t sub = static_cast<size_t>((ns >> shift) & (SubBuckets - 1));
+    return (shift + 1) * SubBuckets + sub;
+}
+
+// Valor més gran que pot contenir una cubeta
+uint64_t LatencyHistogram::bucket_upper(size_t bucket) {
+    if (bucket < SubBuckets) return bucket;
+
+    unsigned shift = static_cast<unsigned>(bucket / SubBuckets) - 1;
+    uint64_t sub = bucket % SubBuckets;
+    uint64_t base = (uint64_t(SubBuckets) + sub) << shift;
+    return base + ((uint64_t(1) << shift) - 1);
+}
+
+void LatencyHistogram::record(uint64_t ns) {
+    counts[bucket_of(ns)]++;
+    samples++;
+    total += ns;
+    if (ns < lowest) lowest = ns;
+    if (ns > highest) highest = ns;
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    if (samples == 0) return 0;
+
+    uint64_t target = static_cast<uint64_t>(p / 100.0 * samples + 0.5);
+    if (target == 0) target = 1;
+
+    uint64_t seen = 0;
+    for (size_t b = 0; b < Buckets; ++b) {
+        seen += counts[b];
+        if (seen >= target) {
+            uint64_t upper = bucket_upper(b);
+            return upper < highest ? upper : highest;
+        }
+    }
+    return highest;
+}
+
+void LatencyHistogram::reset() {
+    counts.fill(0);
+    samples = 0;
+    total = 0;
+    lowest = UINT64_MAX;
+    highest = 0;
+}
+
+string LatencyHistogram::to_json() const {
+    ostringstream out;
+    out << "{\"count\": " << samples
+        << ", \"min_ns\": " << min()
+        << ", \"max_ns\": " << max()
+        << ", \"mean_ns\": " << mean()
+        << ", \"p50_ns\": " << percentile(50)
+        << ", \"p90_ns\": " << percentile(90)
+        << ", \"p99_ns\": " << percentile(99)
+        << ", \"p999_ns\": " << percentile(99.9)
+        << ", \"buckets\": [";
+
+    bool first = true;
+    for (size_t b = 0; b < Buckets; ++b) {
+        if (counts[b] == 0) continue;
+        out << (first ? "" : ", ") << "[" << bucket_upper(b) << ", " << counts[b] << "]";
+        first = false;
+    }
+    out << "]}";
+    return out.str();
+}
+
+void TrieStats::reset() {
+    lookups = 0;
+    nodes_visited = 0;
+    bytes_compared = 0;
+    splits = 0;
+    positions_copied = 0;
+    allocations = 0;
+    insert_latency.reset();
+    search_latency.reset();
+    starts_with_latency.reset();
+    autocomplete_latency.reset();
+}
+
+string TrieStats::to_json() const {
+    ostringstream out;
+    out << "{\n"
+        << "  \"lookups\": " << lookups << ",\n"
+        << "  \"nodes_visited\": " << nodes_visited << ",\n"
+        << "  \"nodes_per_lookup\": " << (lookups ? double(nodes_visited) / lookups : 0.0) << ",\n"
+        << "  \"bytes_compared\": " << bytes_compared << ",\n"
+        << "  \"splits\": " << splits << ",\n"
+        << "  \"positions_copied\": " << positions_copied << ",\n"
+        << "  \"allocations\": " << allocations << ",\n"
+        << "  \"latency\": {\n"
+        << "    \"insert\": " << insert_latency.to_json() << ",\n"
+        << "    \"search\": " << search_latency.to_json() << ",\n"
+        << "    \"starts_with\": " << starts_with_latency.to_json() << ",\n"
+        << "    \"autocomplete\": " << autocomplete_latency.to_json() << "\n"
+        << "  }\n"
+        << "}";
+    return out.str();
+}
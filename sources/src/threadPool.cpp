@@ -0,0 +1,143 @@
+#include "../include/threadPool.h"
+
+// Pool i índex del fil actual, per saber a quina cua van les tasques noves
+static thread_local ThreadPool* current_pool = nullptr;
+static thread_local size_t current_index = 0;
+
+ThreadPool::ThreadPool(size_t count) {
+    if (count == 0) count = max(1u, thread::hardware_concurrency());
+    for (size_t i = 0; i < count; ++i) queues.push_back(make_unique<Queue>());
+    for (size_t i = 0; i < count; ++i) threads.emplace_back([this, i] { worker_loop(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(sleep_lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread& t : threads) t.join();
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::post(function<void()> task) {
+    size_t index = current_pool == this ? current_index : next_queue.fetch_add(1) % queues.size();
+    {
+        lock_guard<mutex> guard(queues[index]->lock);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    queued.fetch_add(1);
+    // Agafar sleep_lock garanteix que un fil que s'està adormint veu la tasca
+    // o rep la notificació
+    { lock_guard<mutex> guard(sleep_lock); }
+    wake.notify_one();
+}
+
+bool ThreadPool::run_pending_task() {
+    bool owner = current_pool == this;
+    return try_run_one(owner ? current_index : next_queue.fetch_add(1) % queues.size(), owner);
+}
+
+// Un fil del pool comença per la seva cua (per darrere); la resta només roba
+bool ThreadPool::try_run_one(size_t self, bool owner) {
+    function<void()> task;
+    if (owner) {
+        Queue& own = *queues[self];
+        lock_guard<mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+    for (size_t k = owner ? 1 : 0; !task && k < queues.size(); ++k) {
+        Queue& victim = *queues[(self + k) % queues.size()];
+        lock_guard<mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+    }
+    if (!task) return false;
+    queued.fetch_sub(1);
+    task();
+    return true;
+}
+
+void ThreadPool::worker_loop(size_t index) {
+    current_pool = this;
+    current_index = index;
+    for (;;) {
+        if (try_run_one(index, true)) continue;
+        unique_lock<mutex> guard(sleep_lock);
+        wake.wait(guard, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) return;
+    }
+}
+
+TaskGroup::TaskGroup(ThreadPool& pool) : pool(pool), state(make_shared<State>()) {}
+
+TaskGroup::~TaskGroup() {
+    // Les tasques encara fan servir el grup: cal esperar-les, però sense llançar
+    try {
+        wait();
+    } catch (...) {
+    }
+}
+
+void TaskGroup::State::execute(function<void()>& task) {
+    exception_ptr thrown;
+    try {
+        task();
+    } catch (...) {
+        thrown = current_exception();
+    }
+    lock_guard<mutex> guard(lock);
+    if (thrown && !error) error = thrown;
+    if (--pending == 0) changed.notify_all();
+}
+
+void TaskGroup::run(function<void()> task) {
+    {
+        lock_guard<mutex> guard(state->lock);
+        state->tasks.push_back(std::move(task));
+        state->pending++;
+    }
+    state->changed.notify_all();
+    // Cada executor agafa la tasca més antiga que quedi, si n'hi ha cap
+    pool.post([state = state] {
+        function<void()> task;
+        {
+            lock_guard<mutex> guard(state->lock);
+            if (state->tasks.empty()) return;
+            task = std::move(state->tasks.front());
+            state->tasks.pop_front();
+        }
+        state->execute(task);
+    });
+}
+
+void TaskGroup::wait() {
+    unique_lock<mutex> guard(state->lock);
+    for (;;) {
+        if (!state->tasks.empty()) {
+            function<void()> task = std::move(state->tasks.back());
+            state->tasks.pop_back();
+            guard.unlock();
+            state->execute(task);
+            guard.lock();
+        } else if (state->pending == 0) {
+            break;
+        } else {
+            state->changed.wait(guard, [this] { return state->pending == 0 || !state->tasks.empty(); });
+        }
+    }
+    if (state->error) {
+        exception_ptr thrown = state->error;
+        state->error = nullptr;
+        rethrow_exception(thrown);
+    }
+}
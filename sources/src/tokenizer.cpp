@@ -0,0 +1,187 @@
+#include "../include/tokenizer.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define TOKENIZER_X86 1
+#include <immintrin.h>
+#endif
+
+// Classificació d'un byte, igual que les versions vectorials
+static bool is_term_byte(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c >= 0x80;
+}
+
+Tokenizer::Tokenizer() : selected(best_isa()) {}
+
+Tokenizer::Tokenizer(Isa isa) : selected(supported(isa) ? isa : Isa::Scalar) {}
+
+bool Tokenizer::supported(Isa isa) {
+#ifdef TOKENIZER_X86
+    if (isa == Isa::AVX2) return __builtin_cpu_supports("avx2");
+    if (isa == Isa::SSE2) return __builtin_cpu_supports("sse2");
+    return true;
+#else
+    return isa == Isa::Scalar;
+#endif
+}
+
+Tokenizer::Isa Tokenizer::best_isa() {
+    if (supported(Isa::AVX2)) return Isa::AVX2;
+    if (supported(Isa::SSE2)) return Isa::SSE2;
+    return Isa::Scalar;
+}
+
+const char* Tokenizer::isa_name(Isa isa) {
+    switch (isa) {
+        case Isa::AVX2: return "AVX2";
+        case Isa::SSE2: return "SSE2";
+        default: return "escalar";
+    }
+}
+
+const vector<Token>& Tokenizer::tokenize(const char* text, size_t length, size_t base_offset) {
+    buffer.resize(length);
+    masks.assign((length + 63) / 64, 0);
+
+    if (selected == Isa::AVX2) classify_avx2(text, length);
+    else if (selected == Isa::SSE2) classify_sse2(text, length);
+    else classify_scalar(text, 0, length);
+
+    clear_separators(text, length);
+    extract_tokens(length, base_offset);
+    return tokens;
+}
+
+void Tokenizer::classify_scalar(const char* text, size_t from, size_t length) {
+    for (size_t i = from; i < length; ++i) {
+        unsigned char c = text[i];
+        buffer[i] = (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32) : static_cast<char>(c);
+        if (is_term_byte(c)) masks[i / 64] |= uint64_t(1) << (i % 64);
+    }
+}
+
+#ifdef TOKENIZER_X86
+
+// Les comparacions de SSE2/AVX2 són amb signe: sumant 0x80 - lo, els bytes
+// de [lo, lo + n) queden a [-128, -128 + n) i n'hi ha prou amb un "menor que"
+
+__attribute__((target("sse2")))
+static inline __m128i in_range_sse2(__m128i x, char lo, char n) {
+    __m128i shifted = _mm_add_epi8(x, _mm_set1_epi8(static_cast<char>(0x80 - lo)));
+    return _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + n)));
+}
+
+__attribute__((target("sse2")))
+void Tokenizer::classify_sse2(const char* text, size_t length) {
+    size_t blocks = length / 64;
+    for (size_t b = 0; b < blocks; ++b) {
+        uint64_t mask = 0;
+        for (size_t part = 0; part < 4; ++part) {
+            size_t i = b * 64 + part * 16;
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+            __m128i upper = in_range_sse2(x, 'A', 26);
+            __m128i term = _mm_or_si128(_mm_or_si128(upper, in_range_sse2(x, 'a', 26)), in_range_sse2(x, '0', 10));
+            __m128i lowered = _mm_add_epi8(x, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&buffer[i]), lowered);
+            // El bit alt de cada byte (>= 0x80) ja el dóna movemask sobre x
+            uint32_t bits = _mm_movemask_epi8(term) | _mm_movemask_epi8(x);
+            mask |= uint64_t(bits) << (part * 16);
+        }
+        masks[b] = mask;
+    }
+    classify_scalar(text, blocks * 64, length);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i in_range_avx2(__m256i x, char lo, char n) {
+    __m256i shifted = _mm256_add_epi8(x, _mm256_set1_epi8(static_cast<char>(0x80 - lo)));
+    return _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(-128 + n)), shifted);
+}
+
+__attribute__((target("avx2")))
+void Tokenizer::classify_avx2(const char* text, size_t length) {
+    size_t blocks = length / 64;
+    for (size_t b = 0; b < blocks; ++b) {
+        uint64_t mask = 0;
+        for (size_t part = 0; part < 2; ++part) {
+            size_t i = b * 64 + part * 32;
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+            __m256i upper = in_range_avx2(x, 'A', 26);
+            __m256i term = _mm256_or_si256(_mm256_or_si256(upper, in_range_avx2(x, 'a', 26)),
+                                           in_range_avx2(x, '0', 10));
+            __m256i lowered = _mm256_add_epi8(x, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&buffer[i]), lowered);
+            uint32_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(term) | _mm256_movemask_epi8(x));
+            mask |= uint64_t(bits) << (part * 32);
+        }
+        masks[b] = mask;
+    }
+    classify_scalar(text, blocks * 64, length);
+}
+
+#else
+
+void Tokenizer::classify_sse2(const char* text, size_t length) { classify_scalar(text, 0, length); }
+void Tokenizer::classify_avx2(const char* text, size_t length) { classify_scalar(text, 0, length); }
+
+#endif
+
+// Separadors de més d'un byte que la classificació ha marcat com a terme:
+// puntuació U+2000-U+206F (E2 80 xx / E2 81 80-AF; els superíndexs
+// U+2070-U+207F, E2 81 B0-BF, són de terme) i U+FEFF (EF BB BF). Es
+// recorren d'esquerra a dreta i cada separador es salta sencer, com faria
+// un recorregut byte a byte (importa si l'UTF-8 no és vàlid)
+void Tokenizer::clear_separators(const char* text, size_t length) {
+    const char* end = text + length;
+    auto find = [&](const char* from, int byte) {
+        const void* hit = from < end ? memchr(from, byte, end - from) : nullptr;
+        return hit ? static_cast<const char*>(hit) : end;
+    };
+
+    const char* next_e2 = find(text, 0xE2);
+    const char* next_ef = find(text, 0xEF);
+    while (next_e2 < end || next_ef < end) {
+        const char* p = next_e2 < next_ef ? next_e2 : next_ef;
+        unsigned char second = p + 1 < end ? p[1] : 0;
+        unsigned char third = p + 2 < end ? p[2] : 0;
+        bool separator = *p == '\xE2' ? second == 0x80 || (second == 0x81 && third < 0xB0)
+                                      : second == 0xBB && p + 2 < end && third == 0xBF;
+        const char* resume = p + 1;
+        if (separator) {
+            resume = p + 3 < end ? p + 3 : end;
+            for (size_t i = p - text; i < static_cast<size_t>(resume - text); ++i) {
+                masks[i / 64] &= ~(uint64_t(1) << (i % 64));
+            }
+        }
+        if (next_e2 < resume) next_e2 = find(resume, 0xE2);
+        if (next_ef < resume) next_ef = find(resume, 0xEF);
+    }
+}
+
+// Un terme comença on un bit 1 va precedit d'un 0 i acaba al primer 0
+// següent; el bit del byte anterior a cada paraula de 64 bits passa a 'carry'
+void Tokenizer::extract_tokens(size_t length, size_t base_offset) {
+    tokens.clear();
+    size_t start = 0;
+    uint64_t carry = 0;
+
+    for (size_t w = 0; w < masks.size(); ++w) {
+        uint64_t mask = masks[w];
+        uint64_t previous = (mask << 1) | carry;
+        uint64_t starts = mask & ~previous;
+        uint64_t events = starts | (~mask & previous);
+        carry = mask >> 63;
+
+        while (events) {
+            unsigned bit = __builtin_ctzll(events);
+            events &= events - 1;
+            size_t position = w * 64 + bit;
+            if ((starts >> bit) & 1) {
+                start = position;
+            } else {
+                tokens.push_back({string_view(buffer.data() + start, position - start), base_offset + start});
+            }
+        }
+    }
+    if (carry) tokens.push_back({string_view(buffer.data() + start, length - start), base_offset + start});
+}
@@ -0,0 +1,45 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Comprovacions deterministes mínimes per a `make check`
+ *
+ * Cada fitxer tests/check_*.cpp registra els seus casos amb CHECK_CASE. CHECK
+ * anota el fitxer i la línia de cada condició falsa i el cas continua; el
+ * programa acaba amb codi 1 si n'ha fallat cap.
+ */
+struct CheckCase {
+    const char* name;
+    void (*run)();
+};
+
+vector<CheckCase>& check_cases();
+void check_failed(const char* file, int line, const char* expression);
+
+/**
+ * @brief Paraules pseudoaleatòries reproduïbles (amb repeticions i prefixos comuns)
+ * @param count Nombre de paraules
+ * @param letters Mida de l'alfabet, a partir de 'a'
+ * @param seed Llavor del generador
+ */
+vector<string> check_words(size_t count, int letters = 4, unsigned seed = 1);
+
+struct CheckRegistration {
+    CheckRegistration(const char* name, void (*run)()) { check_cases().push_back({name, run}); }
+};
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) check_failed(__FILE__, __LINE__, #condition); \
+    } while (0)
+
+#define CHECK_CASE(name) \
+    static void name(); \
+    static CheckRegistration name##_registration(#name, name); \
+    static void name()
+
+#endif // CHECK_H
@@ -0,0 +1,114 @@
+// Comprovacions del ThreadPool, dels TaskGroup i de l'AsyncTrie
+
+#include "check.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include "asyncTrie.h"
+#include "naive.h"
+using namespace std;
+
+// Suma de [begin, end) partint en dos mentre el tros és gran
+static long long fork_sum(long long begin, long long end, ThreadPool& pool) {
+    if (end - begin < 64) {
+        long long sum = 0;
+        for (long long i = begin; i < end; ++i) sum += i;
+        return sum;
+    }
+    long long middle = begin + (end - begin) / 2, left = 0;
+    TaskGroup group(pool);
+    group.run([&] { left = fork_sum(begin, middle, pool); });
+    long long right = fork_sum(middle, end, pool);
+    group.wait();
+    return left + right;
+}
+
+// user-049: fork-join niat, tasques afegides des del grup i excepcions
+CHECK_CASE(task_group_fork_join) {
+    ThreadPool pool(3);
+    CHECK(fork_sum(0, 100000, pool) == 100000LL * 99999 / 2);
+    CHECK(pool.submit([&] { return fork_sum(0, 5000, pool); }).get() == 5000LL * 4999 / 2);
+
+    atomic<int> done{0};
+    TaskGroup group(pool);
+    for (int i = 0; i < 50; ++i) {
+        group.run([&] {
+            done++;
+            group.run([&] { done++; });
+        });
+    }
+    group.wait();
+    CHECK(done == 100);
+
+    group.run([] { throw runtime_error("tasca"); });
+    group.run([&] { done++; });
+    bool thrown = false;
+    try {
+        group.wait();
+    } catch (const runtime_error&) {
+        thrown = true;
+    }
+    CHECK(thrown && done == 101);
+    group.wait();  // l'error ja s'ha lliurat
+}
+
+// user-049: wait() no executa tasques del pool alienes al grup, que podrien
+// necessitar un lock que el fil que espera té agafat
+CHECK_CASE(task_group_waits_only_for_its_tasks) {
+    ThreadPool pool(1);
+    bool holding = false, foreign_inside = false, own_ran = false;
+    promise<void> foreign_done;
+    pool.submit([&] {
+        holding = true;
+        TaskGroup group(pool);
+        group.run([&] { own_ran = true; });
+        // Va a la mateixa cua, darrere de l'executor del grup
+        pool.post([&] {
+            foreign_inside = holding;
+            foreign_done.set_value();
+        });
+        group.wait();
+        holding = false;
+    }).get();
+    foreign_done.get_future().wait();
+    CHECK(own_ran);
+    CHECK(!foreign_inside);
+}
+
+// user-049: consultes que fan fork-join amb el lock compartit agafat i
+// insercions que esperen el lock exclusiu, totes al mateix pool
+CHECK_CASE(async_trie_queries_and_inserts) {
+    ThreadPool pool(4);
+    auto backend = make_unique<NaiveTrie>();
+    vector<string> words = check_words(20000, 6, 31);
+    for (const string& word : words) backend->insert(word);
+    size_t distinct = backend->get_all_words().size();
+    AsyncTrie trie(std::move(backend), pool);
+
+    for (int round = 0; round < 3; ++round) {
+        vector<future<vector<string>>> queries;
+        vector<future<void>> inserts;
+        for (int i = 0; i < 8; ++i) {
+            queries.push_back(trie.get_words_with_prefix(""));
+            inserts.push_back(trie.insert("z" + to_string(round) + to_string(i)));
+        }
+
+        bool finished = true;
+        auto deadline = chrono::steady_clock::now() + chrono::seconds(30);
+        for (auto& query : queries) finished = finished && query.wait_until(deadline) == future_status::ready;
+        for (auto& insert : inserts) finished = finished && insert.wait_until(deadline) == future_status::ready;
+        if (!finished) {
+            // Un pool encallat no es pot destruir: no té sentit continuar
+            check_failed(__FILE__, __LINE__, "consultes i insercions encallades");
+            fputs("AsyncTrie encallat\n", stderr);
+            _Exit(1);
+        }
+        for (auto& query : queries) {
+            size_t count = query.get().size();
+            CHECK(count >= distinct + 8 * round && count <= distinct + 8 * (round + 1));
+        }
+    }
+    CHECK(trie.search("z07").get());
+    CHECK(trie.get_words_with_prefix("z2").get().size() == 8);
+}
@@ -0,0 +1,35 @@
+// Comprovacions del BitRadixTrie
+
+#include "check.h"
+#include "bitRadix.h"
+using namespace std;
+
+template <unsigned Bits>
+static void fill(BitRadixTrie<Bits>& trie, const vector<string>& words) {
+    for (size_t i = 0; i < words.size(); ++i) trie.insert(words[i], static_cast<int>(i));
+}
+
+// user-031: tots els passos de bits donen les mateixes respostes, en ordre
+CHECK_CASE(bitradix_bits_per_level_agree) {
+    vector<string> words = check_words(400, 5, 3);
+    words.push_back("\xff\x80 high bytes");
+    BinaryRadixTrie binary;
+    NibbleRadixTrie nibble;
+    ByteRadixTrie bytes;
+    fill(binary, words);
+    fill(nibble, words);
+    fill(bytes, words);
+
+    CHECK(binary.get_words() == bytes.get_words());
+    CHECK(nibble.get_words() == bytes.get_words());
+    for (const string& prefix : {string(""), string("a"), string("cab"), string("eeee"), string("\xff")}) {
+        CHECK(binary.autocomplete(prefix) == bytes.autocomplete(prefix));
+        CHECK(nibble.starts_with(prefix).size() == bytes.starts_with(prefix).size());
+    }
+    CHECK(bytes.search("\xff\x80 high bytes") == vector<int>({static_cast<int>(words.size() - 1)}));
+
+    // Menys bits per nivell: més nodes, però més petits
+    CHECK(binary.node_count() > nibble.node_count() && nibble.node_count() > bytes.node_count());
+    bytes.clear();
+    CHECK(bytes.empty());
+}
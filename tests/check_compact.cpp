@@ -0,0 +1,49 @@
+// Comprovacions del CompactRadixTrie
+
+#include "check.h"
+#include "compactRadix.h"
+using namespace std;
+
+// user-035: totes les disposicions responen igual que el RadixTrie d'origen
+CHECK_CASE(compact_layouts_match_radix) {
+    vector<string> words = check_words(500, 5, 11);
+    RadixTrie radix;
+    for (size_t i = 0; i < words.size(); ++i) radix.insert(words[i], static_cast<int>(i));
+
+    for (auto layout : {CompactRadixTrie::Layout::BreadthFirst, CompactRadixTrie::Layout::Preorder,
+                        CompactRadixTrie::Layout::VanEmdeBoas}) {
+        CompactRadixTrie compact(radix, layout);
+        CHECK(compact.node_count() == radix.profile().nodes);
+        CHECK(compact.get_words() == radix.get_words());
+        for (const string& key : {string("a"), string("abc"), string("eeee"), string("bad"), string("zz")}) {
+            CHECK(compact.search(key) == radix.search(key));
+            CHECK(compact.starts_with(key) == radix.starts_with(key));
+            CHECK(compact.autocomplete(key) == radix.autocomplete(key));
+        }
+    }
+    CHECK(CompactRadixTrie().empty());
+}
+
+// user-035: etiquetes del text, del pool i inline; la còpia d'un índex de
+// sufixos ocupa O(n), no la suma de les longituds dels sufixos
+CHECK_CASE(compact_shares_text_and_pool) {
+    string text;
+    for (const string& word : check_words(1500, 6, 13)) text += word + ' ';
+    RadixTrie suffixes;
+    suffixes.init(text);
+    CompactRadixTrie compact(suffixes, CompactRadixTrie::Layout::Preorder);
+    CHECK(compact.get_words() == suffixes.get_words());
+    for (const string& key : {text.substr(0, 20), text.substr(100, 3), string("ab"), text.substr(text.length() - 30)}) {
+        CHECK(compact.search(key) == suffixes.search(key));
+        CHECK(compact.starts_with(key) == suffixes.starts_with(key));
+    }
+    CHECK(compact.profile().label_bytes < 4 * text.length());
+
+    RadixTrie words;
+    words.insert("internacionalitzacio", 1);
+    words.insert("internacionalment", 2);
+    words.insert("inter", 3);
+    CompactRadixTrie copy(words);
+    CHECK(copy.search("internacionalitzacio") == vector<int>{1});
+    CHECK(copy.autocomplete("internacional") == words.autocomplete("internacional"));
+}
@@ -0,0 +1,66 @@
+// Comprovacions de l'índex invertit de documents
+
+#include "check.h"
+#include "docIndex.h"
+using namespace std;
+
+static const string FirstDocument =
+    "Alice was beginning to get very tired\n"
+    "of sitting by her sister on the bank.\n"
+    "\n"
+    "Down the rabbit hole went Alice.";
+
+static const string SecondDocument = "The White Rabbit ran; Alice followed the rabbit.";
+
+// user-036: ocurrències per document amb línia, paràgraf i ordinal
+CHECK_CASE(docindex_postings) {
+    DocumentIndex index;
+    uint32_t first = index.add_document("first", FirstDocument);
+    uint32_t second = index.add_document("second", SecondDocument);
+    CHECK(index.document_count() == 2 && index.find_document("second") == static_cast<int>(second));
+
+    vector<DocumentIndex::Posting> alice = index.lookup("Alice");
+    CHECK(alice.size() == 3);
+    CHECK(alice[0].doc == first && alice[0].word == 0 && alice[0].line == 0 && alice[0].paragraph == 0);
+    CHECK(alice[1].doc == first && alice[1].line == 3 && alice[1].paragraph == 1);
+    CHECK(alice[2].doc == second && alice[2].word == 4);
+
+    CHECK(index.lookup("rabbit", second).size() == 2);
+    CHECK(index.lookup("rabbit", first).size() == 1);
+    CHECK(index.lookup("hatter").empty());
+    CHECK(index.terms_with_prefix("si") == vector<string>({"sister", "sitting"}));
+    CHECK(index.posting_count() == index.document_words(first) + index.document_words(second));
+}
+
+// user-037: frases i proximitat; les consultes es parteixen igual que el text
+CHECK_CASE(docindex_phrase_near_and_query_terms) {
+    DocumentIndex index;
+    index.add_document("first", FirstDocument);
+    uint32_t second = index.add_document("second", SecondDocument + " Don't stop.");
+
+    vector<DocumentIndex::Posting> phrase = index.phrase_search("the RABBIT");
+    CHECK(phrase.size() == 2);
+    CHECK(index.phrase_search("rabbit the").empty());
+    CHECK(index.phrase_search("followed the rabbit", second).size() == 1);
+
+    auto pairs = index.near("alice", "rabbit", 2);
+    CHECK(pairs.size() == 1 && pairs[0].first.doc == second);
+    CHECK(index.near("alice", "rabbit", 5).size() == 2);
+    // Una k enorme vol dir "a qualsevol lloc del document" (sense desbordar word + k)
+    CHECK(index.near("alice", "rabbit", UINT32_MAX).size() == 3);
+    auto anywhere = index.near("alice", "rabbit", UINT32_MAX);
+    auto wide = index.near("alice", "rabbit", 1000);
+    CHECK(anywhere.size() == wide.size());
+    for (size_t i = 0; i < anywhere.size() && i < wide.size(); ++i)
+        CHECK(anywhere[i].second.doc == wide[i].second.doc && anywhere[i].second.word == wide[i].second.word);
+
+    // "don't" són els termes "don" i "t", com els parteix el Tokenizer
+    CHECK(DocumentIndex::normalize("Rabbit") == "rabbit");
+    CHECK(DocumentIndex::normalize("don't").empty());
+    CHECK(DocumentIndex::normalize("\xEF\xBB\xBFRabbit") == "rabbit");
+    CHECK(index.lookup("don").size() == 1);
+    CHECK(index.lookup("dont").empty() && index.lookup("don't").empty());
+    CHECK(index.phrase_search("don't stop").size() == 1);
+    CHECK(index.lookup("\xEF\xBB\xBF" "alice").size() == 3);
+    CHECK(index.terms_with_prefix("don t").empty());
+}
@@ -0,0 +1,101 @@
+// Comprovacions dels decoradors de Trie (filtre de Bloom i cache)
+
+#include "check.h"
+#include <algorithm>
+#include "bloomFilter.h"
+#include "cachedTrie.h"
+#include "filteredTrie.h"
+#include "naive.h"
+using namespace std;
+
+// user-042: sense falsos negatius, amb pocs falsos positius, i el decorador respon igual
+CHECK_CASE(bloom_filter_and_filtered_trie) {
+    BlockedBloomFilter filter(1000, 12);
+    for (uint64_t i = 0; i < 1000; ++i) filter.add(i * 0x9E3779B97F4A7C15ULL);
+    size_t false_positives = 0;
+    for (uint64_t i = 0; i < 1000; ++i) CHECK(filter.may_contain(i * 0x9E3779B97F4A7C15ULL));
+    for (uint64_t i = 1000; i < 11000; ++i) false_positives += filter.may_contain(i * 0x9E3779B97F4A7C15ULL);
+    CHECK(false_positives < 300);  // ~1% esperat amb 12 bits per element
+
+    // Pocs elements previstos: el filtre s'ha de refer en créixer
+    FilteredTrie filtered(make_unique<NaiveTrie>(), 3, 4);
+    NaiveTrie plain;
+    vector<string> words = check_words(600, 5, 19);
+    for (size_t i = 0; i < words.size(); i += 2) {
+        filtered.insert(words[i]);
+        plain.insert(words[i]);
+    }
+    for (const string& word : words) {
+        CHECK(filtered.search(word) == plain.search(word));
+        CHECK(filtered.starts_with(word) == plain.starts_with(word));
+        CHECK(filtered.get_words_with_prefix(word) == plain.get_words_with_prefix(word));
+    }
+    CHECK(filtered.rejected() > 0);
+    CHECK(filtered.get_all_words() == plain.get_all_words());
+    filtered.clear();
+    CHECK(filtered.empty() && !filtered.search(words[0]));
+}
+
+// user-047: la cache respon igual que el trie decorat, també després d'insert i invalidate
+CHECK_CASE(cached_trie_matches_plain) {
+    auto backend = make_unique<NaiveTrie>();
+    NaiveTrie* inner = backend.get();
+    CachedTrie cached(std::move(backend), 64, 4);
+    NaiveTrie plain;
+    vector<string> words = check_words(800, 4, 23);
+    vector<string> prefixes = {"", "a", "ab", "b", "dd", "abc", "abce"};
+    auto same_answers = [&] {
+        for (const string& prefix : prefixes) {
+            CHECK(cached.search(prefix) == plain.search(prefix));
+            CHECK(cached.starts_with(prefix) == plain.starts_with(prefix));
+            CHECK(cached.get_words_with_prefix(prefix) == plain.get_words_with_prefix(prefix));
+            vector<string> ordered = plain.get_words_with_prefix(prefix);
+            sort(ordered.begin(), ordered.end());
+            ordered.resize(min<size_t>(ordered.size(), 5));
+            CHECK(cached.get_words_with_prefix(prefix, 5) == ordered);
+        }
+    };
+
+    for (size_t i = 0; i < words.size(); i += 2) {
+        cached.insert(words[i]);
+        plain.insert(words[i]);
+    }
+    same_answers();
+    same_answers();  // ara des de la cache
+    CHECK(cached.hits() > 0);
+
+    // Cada insert invalida els prefixos de la paraula i prou
+    for (size_t i = 1; i < words.size(); i += 2) {
+        cached.insert(words[i]);
+        plain.insert(words[i]);
+        if (i % 100 == 1) same_answers();
+    }
+    cached.insert("ab");
+    plain.insert("ab");
+    same_answers();
+    CHECK(cached.size() <= 64);
+
+    // Canvis per fora del decorador: sense invalidate() la cache no els veu
+    CHECK(!cached.search("abce"));
+    inner->insert("abce");
+    plain.insert("abce");
+    CHECK(!cached.search("abce"));
+    cached.invalidate("abce");
+    same_answers();
+
+    // Molts límits diferents per al mateix prefix: els petits es treuen dels
+    // grans ja guardats i cada entrada en guarda pocs
+    vector<string> ordered = plain.get_words_with_prefix("a");
+    sort(ordered.begin(), ordered.end());
+    CHECK(ordered.size() > 120);
+    if (ordered.size() <= 120) return;
+    uint64_t misses = cached.misses();
+    CHECK(cached.get_words_with_prefix("a", 100) == vector<string>(ordered.begin(), ordered.begin() + 100));
+    for (size_t limit = 99; limit > 0; --limit)
+        CHECK(cached.get_words_with_prefix("a", limit) == vector<string>(ordered.begin(), ordered.begin() + limit));
+    CHECK(cached.misses() <= misses + 1);
+    for (size_t limit = 101; limit < 120; ++limit)
+        CHECK(cached.get_words_with_prefix("a", limit) == vector<string>(ordered.begin(), ordered.begin() + limit));
+    CHECK(cached.get_words_with_prefix("a", ordered.size() + 5) == ordered);
+    CHECK(cached.get_words_with_prefix("a", ordered.size() + 50) == ordered);
+}
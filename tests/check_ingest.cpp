@@ -0,0 +1,75 @@
+// Comprovacions de la ingesta en pipeline
+
+#include "check.h"
+#include "ingest.h"
+#include "radixDone.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+using namespace std;
+
+static string write_temp(const string& name, const string& text) {
+    string path = (filesystem::temp_directory_path() / name).string();
+    ofstream(path, ios::binary) << text;
+    return path;
+}
+
+static vector<pair<string, int>> sorted_words(const RadixTrie& trie) {
+    vector<pair<string, int>> words = trie.get_words();
+    sort(words.begin(), words.end());
+    return words;
+}
+
+// user-039: el pipeline dona els mateixos termes i posicions que un sol bucle
+CHECK_CASE(ingest_pipeline_matches_sequential) {
+    vector<string> words = check_words(3000, 6, 13);
+    string first, second;
+    for (size_t i = 0; i < words.size(); ++i) (i % 2 ? second : first) += words[i] + (i % 7 ? " " : ".\n");
+    vector<string> files = {write_temp("check_ingest_a.txt", first), write_temp("check_ingest_b.txt", second)};
+
+    RadixTrie expected;
+    Tokenizer tokenizer;
+    size_t base = 0;
+    for (const string& text : {first, second}) {
+        for (const Token& token : tokenizer.tokenize(text, base))
+            expected.insert(string(token.text), static_cast<int>(token.offset));
+        base += text.length();
+    }
+
+    RadixTrie shards[3];
+    IngestOptions options;
+    options.lanes = 2;
+    options.chunk_bytes = 97;  // blocs petits: molts talls a mig terme
+    options.batch_tokens = 5;
+    IngestStats stats = IngestPipeline<RadixTrie>({&shards[0], &shards[1], &shards[2]}, options).run(files);
+    CHECK(stats.failed_files == 0 && stats.bytes == first.length() + second.length());
+
+    vector<pair<string, int>> merged;
+    for (const RadixTrie& shard : shards) {
+        vector<pair<string, int>> part = shard.get_words();
+        merged.insert(merged.end(), part.begin(), part.end());
+    }
+    sort(merged.begin(), merged.end());
+    CHECK(merged == sorted_words(expected));
+    for (const string& file : files) filesystem::remove(file);
+}
+
+// user-039: un fitxer amb posicions més enllà d'INT_MAX no es llegeix
+CHECK_CASE(ingest_rejects_positions_past_int_max) {
+    // Fitxer dispers: ocupa un bloc però fa més de 2 GiB
+    string huge = (filesystem::temp_directory_path() / "check_ingest_huge.txt").string();
+    {
+        ofstream file(huge, ios::binary);
+        file.seekp(static_cast<streamoff>(IngestPipeline<RadixTrie>::MaxBytes));
+        file << "past";
+    }
+    string small = write_temp("check_ingest_small.txt", "alpha beta");
+
+    RadixTrie trie;
+    IngestStats stats = IngestPipeline<RadixTrie>({&trie}).run({huge, small});
+    CHECK(stats.oversized_files == 1);
+    CHECK(trie.search("beta") == vector<int>({6}));
+    CHECK(trie.search("past").empty());
+    filesystem::remove(huge);
+    filesystem::remove(small);
+}
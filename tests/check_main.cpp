@@ -0,0 +1,63 @@
+// Executa tots els casos registrats; amb arguments, només els que contenen algun d'ells
+
+#include "check.h"
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+using namespace std;
+
+static int failures = 0;
+
+vector<CheckCase>& check_cases() {
+    static vector<CheckCase> cases;
+    return cases;
+}
+
+void check_failed(const char* file, int line, const char* expression) {
+    cerr << "  " << file << ":" << line << ": falla " << expression << endl;
+    failures++;
+}
+
+vector<string> check_words(size_t count, int letters, unsigned seed) {
+    // LCG propi: el resultat no depèn de la biblioteca estàndard
+    uint32_t state = seed;
+    auto next = [&state](uint32_t bound) {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 16) % bound;
+    };
+    vector<string> words;
+    for (size_t i = 0; i < count; ++i) {
+        string word(1 + next(8), 'a');
+        for (char& c : word) c = static_cast<char>('a' + next(static_cast<uint32_t>(letters)));
+        words.push_back(word);
+    }
+    return words;
+}
+
+int main(int argc, char* argv[]) {
+    size_t run = 0;
+    size_t failed = 0;
+    for (const CheckCase& test : check_cases()) {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; ++i) selected = selected || strstr(test.name, argv[i]) != nullptr;
+        if (!selected) continue;
+
+        int before = failures;
+        try {
+            test.run();
+        } catch (const exception& e) {
+            cerr << "  excepció: " << e.what() << endl;
+            failures++;
+        }
+        run++;
+        if (failures != before) {
+            failed++;
+            cout << "✗ " << test.name << endl;
+        } else {
+            cout << "✓ " << test.name << endl;
+        }
+    }
+    cout << run - failed << "/" << run << " casos correctes" << endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+// Comprovacions del NaiveTrie i de les polítiques d'alfabet
+
+#include "check.h"
+#include "naive.h"
+#include <algorithm>
+using namespace std;
+
+// user-030: cada alfabet només accepta els seus símbols
+CHECK_CASE(naive_alphabets) {
+    LowercaseNaiveTrie lower;
+    lower.insert("hello", 1);
+    lower.insert("Hello", 2);
+    CHECK(lower.search("hello") && !lower.search("Hello"));
+    CHECK(lower.get_words().size() == 1);
+
+    BasicNaiveTrie<DnaAlphabet> dna;
+    dna.insert("GATTACA", 1);
+    dna.insert("GATC", 2);
+    dna.insert("GATX", 3);
+    CHECK(dna.starts_with_positions("GAT").size() == 2);
+    CHECK(!dna.search("GATX"));
+
+    BasicNaiveTrie<BinaryAlphabet> binary;
+    binary.insert("0110", 1);
+    binary.insert("012", 2);
+    CHECK(binary.search("0110") && !binary.starts_with("012"));
+
+    NaiveTrie bytes;
+    bytes.insert("caf\xc3\xa9", 1);
+    bytes.insert("caf\xc3\xa8", 2);
+    CHECK(bytes.starts_with_positions("caf\xc3").size() == 2);
+    CHECK(bytes.get_words_with_prefix("caf") == vector<string>({"caf\xc3\xa8", "caf\xc3\xa9"}));
+}
+
+// user-050: només es reparteixen els subarbres grans, i el resultat és el
+// mateix que el del recorregut seqüencial
+CHECK_CASE(naive_parallel_enumeration) {
+    NaiveTrie small;
+    for (const string& word : check_words(200, 4, 7)) small.insert(word, 1);
+    CHECK(!small.enumerates_in_parallel(""));
+    CHECK(!small.enumerates_in_parallel("a"));
+
+    NaiveTrie large;
+    vector<string> words = check_words(20000, 6, 31);
+    for (size_t i = 0; i < words.size(); ++i) large.insert(words[i], static_cast<int>(i));
+#ifndef TRIE_STATS
+    CHECK(large.enumerates_in_parallel(""));
+#endif
+    CHECK(!large.enumerates_in_parallel("abc"));
+    CHECK(!large.enumerates_in_parallel("zz"));
+
+    for (const string& prefix : {string(""), string("a"), string("f")}) {
+        large.set_parallel_enumeration(true);
+        vector<string> words_parallel = large.get_words_with_prefix(prefix);
+        vector<pair<string, int>> autocomplete_parallel = large.autocomplete(prefix);
+        vector<int> positions_parallel = large.starts_with_positions(prefix);
+        large.set_parallel_enumeration(false);
+        CHECK(!large.enumerates_in_parallel(prefix));
+        CHECK(words_parallel == large.get_words_with_prefix(prefix));
+        CHECK(autocomplete_parallel == large.autocomplete(prefix));
+        CHECK(positions_parallel == large.starts_with_positions(prefix));
+    }
+}
@@ -0,0 +1,142 @@
+// Comprovacions del PatriciaTrie
+
+#include "check.h"
+#include "patricia.h"
+#include <algorithm>
+using namespace std;
+
+static vector<string> keys_of(const vector<pair<string, int>>& words) {
+    vector<string> keys;
+    for (const auto& word : words) keys.push_back(word.first);
+    sort(keys.begin(), keys.end());
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+}
+
+// user-026: claus de més de 32 caràcters i prefix buit
+CHECK_CASE(patricia_long_keys_and_empty_prefix) {
+    PatriciaTrie trie;
+    string longer(100, 'a');
+    trie.insert(longer, 1);
+    trie.insert(longer + "b", 2);
+    trie.insert("abc", 3);
+    CHECK(trie.search(longer));
+    CHECK(trie.search(longer + "b"));
+    CHECK(!trie.search(longer + "c"));
+
+    CHECK(trie.has_prefix(""));
+    CHECK(trie.starts_with_positions("").size() == 3);
+    CHECK(trie.autocomplete("").size() == 3);
+
+    PatriciaTrie empty;
+    CHECK(!empty.has_prefix(""));
+    CHECK(empty.starts_with_positions("").empty());
+
+    // Claus sense posicions: has_prefix no depèn de les posicions
+    PatriciaTrie bare;
+    bare.insert("xyz");
+    CHECK(bare.has_prefix("") && bare.has_prefix("xy") && !bare.has_prefix("xz"));
+}
+
+// user-027: el descens pels bits del prefix dóna el mateix que filtrar totes les claus
+CHECK_CASE(patricia_prefix_descent_matches_scan) {
+    vector<string> words = check_words(500);
+    PatriciaTrie trie;
+    for (size_t i = 0; i < words.size(); ++i) trie.insert(words[i], static_cast<int>(i));
+
+    vector<string> keys = keys_of(trie.get_words());
+    for (const string& prefix : {string("a"), string("ab"), string("dca"), string("bbbb"), string("abcdabcd"), string("e")}) {
+        vector<string> expected;
+        for (const string& key : keys)
+            if (key.compare(0, prefix.length(), prefix) == 0) expected.push_back(key);
+        CHECK(keys_of(trie.autocomplete(prefix)) == expected);
+
+        size_t positions = 0;
+        for (size_t i = 0; i < words.size(); ++i)
+            if (words[i].compare(0, prefix.length(), prefix) == 0) positions++;
+        CHECK(trie.starts_with_positions(prefix).size() == positions);
+        CHECK(trie.has_prefix(prefix) == !expected.empty());
+    }
+}
+
+// user-028: claus que només difereixen en un bit, dins i fora dels blocs de 8 bytes
+CHECK_CASE(patricia_critical_bit_blocks) {
+    string base = "abcdefghijklmnopqrstuvwx";
+    PatriciaTrie trie;
+    vector<string> keys;
+    for (size_t i = 0; i < base.length(); ++i) {
+        for (int b = 0; b < 7; ++b) {
+            string key = base;
+            key[i] = static_cast<char>(key[i] ^ (1 << b));
+            keys.push_back(key);
+        }
+        keys.push_back(base.substr(0, i + 1));
+    }
+    for (size_t i = 0; i < keys.size(); ++i) trie.insert(keys[i], static_cast<int>(i));
+    for (size_t i = 0; i < keys.size(); ++i) {
+        vector<int> positions = trie.search_positions(keys[i]);
+        CHECK(!positions.empty() && positions.front() == static_cast<int>(i));
+    }
+    CHECK(!trie.search(base + "y"));
+
+    // Els '\0' finals no distingeixen claus: van a la mateixa fulla
+    trie.insert(base + string(3, '\0'), 1000);
+    CHECK(trie.search_positions(base).size() == 2);
+}
+
+// user-029: nodes interns només de ramificació i claus a les fulles
+CHECK_CASE(patricia_internal_nodes_and_leaves) {
+    vector<string> words = check_words(300, 6, 7);
+    PatriciaTrie trie;
+    for (size_t i = 0; i < words.size(); ++i) trie.insert(words[i], static_cast<int>(i));
+
+    vector<string> keys = keys_of(trie.get_words());
+    TrieProfile report = trie.profile();
+    CHECK(report.keys == keys.size());
+    CHECK(report.nodes == 2 * keys.size() - 1);
+    CHECK(report.positions == words.size());
+
+    // Les fulles surten en ordre lexicogràfic
+    vector<string> walk;
+    for (const auto& word : trie.get_words())
+        if (walk.empty() || walk.back() != word.first) walk.push_back(word.first);
+    CHECK(walk == keys);
+
+    trie.makeEmpty();
+    CHECK(trie.isEmpty());
+    CHECK(trie.get_words().empty());
+}
+
+// Claus de 'keys' que són prefix de 'input', de més curta a més llarga
+static vector<size_t> prefix_lengths(const vector<string>& keys, const string& input) {
+    vector<size_t> lengths;
+    for (const string& key : keys)
+        if (key.length() <= input.length() && input.compare(0, key.length(), key) == 0) lengths.push_back(key.length());
+    sort(lengths.begin(), lengths.end());
+    lengths.erase(unique(lengths.begin(), lengths.end()), lengths.end());
+    return lengths;
+}
+
+// user-045: prefix més llarg i tots els prefixos, comparats amb provar cada clau
+CHECK_CASE(patricia_prefix_matches) {
+    vector<string> keys = check_words(400, 3, 31);
+    for (size_t n = 1; n <= 40; ++n) keys.push_back(string(n, 'a'));  // cadena profunda de bits 0
+    keys.push_back(string("zz\0\0", 4));
+    PatriciaTrie trie;
+    for (size_t i = 0; i < keys.size(); ++i) trie.insert(keys[i], static_cast<int>(i));
+
+    vector<string> inputs = check_words(200, 3, 37);
+    inputs.push_back(string(50, 'a'));
+    inputs.push_back(string("zz\0\0c", 5));
+    inputs.push_back("zz");
+    inputs.push_back("");
+    for (const string& input : inputs) {
+        vector<size_t> expected = prefix_lengths(keys, input);
+        vector<PrefixMatch> matches = trie.all_prefix_matches(input);
+        vector<size_t> lengths;
+        for (const PrefixMatch& match : matches) lengths.push_back(match.length);
+        CHECK(lengths == expected);
+        CHECK(trie.longest_prefix_match(input).length == (expected.empty() ? 0 : expected.back()));
+    }
+    CHECK(sizeof(PatriciaInternalNode) == 32 || sizeof(void*) != 8);
+}
@@ -0,0 +1,50 @@
+// Comprovacions del protocol de línies del servidor
+
+#include "check.h"
+#include "queryProtocol.h"
+using namespace std;
+
+// user-048: respostes de cada operació, i A no es pot fer servir amb sufixos
+CHECK_CASE(query_protocol_answers) {
+    RadixTrie words;
+    words.insert("hola", 0);
+    words.insert("hola", 12);
+    words.insert("home", 5);
+    words.insert("ho", 9);
+    CHECK(answer_query(words, "S hola", false) == "2 0 12");
+    CHECK(answer_query(words, "S hol", false) == "0");
+    CHECK(answer_query(words, "C ho", false) == "4");
+    CHECK(answer_query(words, "A 2 ho", false) == "ho\thola");
+    CHECK(answer_query(words, "A 10 hom", false) == "home");
+    CHECK(answer_query(words, "A 0 ho", false).empty());
+    CHECK(answer_query(words, "A x ho", false).compare(0, 3, "ERR") == 0);
+    CHECK(answer_query(words, "L holanda", false) == "4");
+    CHECK(answer_query(words, "X ho", false).compare(0, 3, "ERR") == 0);
+    CHECK(answer_query(words, "Sho", false).compare(0, 3, "ERR") == 0);
+    CHECK(answer_query(words, "", false).compare(0, 3, "ERR") == 0);
+
+    // Els sufixos contenen salts de línia: cap resposta no n'ha de tenir
+    RadixTrie suffixes;
+    suffixes.init("ab\nab\tc\n");
+    for (const string& line : {string("A 5 "), string("A 5 a"), string("S ab\n"), string("C ab"), string("L ab")}) {
+        string response = answer_query(suffixes, line, true);
+        CHECK(response.find('\n') == string::npos);
+    }
+    CHECK(answer_query(suffixes, "A 5 a", true).compare(0, 3, "ERR") == 0);
+    CHECK(answer_query(suffixes, "C ab", true) == "2");
+}
+
+// user-048: les línies es treuen del buffer amb un màxim per lot
+CHECK_CASE(query_protocol_lines) {
+    string input = "S a\r\nC b\n\nL c\nA 2 d";
+    vector<string> lines;
+    CHECK(take_lines(input, 2, lines));
+    CHECK(lines == vector<string>({"S a", "C b"}));
+    CHECK(!take_lines(input, 10, lines));
+    CHECK(lines == vector<string>({"S a", "C b", "", "L c"}));
+    CHECK(input == "A 2 d");
+    CHECK(!take_lines(input, 10, lines) && lines.size() == 4);
+    input += "\n";
+    CHECK(take_lines(input, 0, lines) && input == "A 2 d\n");
+    CHECK(!take_lines(input, 1, lines) && input.empty() && lines.back() == "A 2 d");
+}
@@ -0,0 +1,240 @@
+// Comprovacions del RadixTrie (índex de paraules i índex de sufixos)
+
+#include "check.h"
+#include "radixDone.h"
+#include <algorithm>
+#include <set>
+using namespace std;
+
+// Posicions on apareix 'pattern' dins de 'text', en ordre
+static vector<int> occurrences(const string& text, const string& pattern) {
+    vector<int> positions;
+    for (size_t i = 0; i + pattern.length() <= text.length(); ++i)
+        if (text.compare(i, pattern.length(), pattern) == 0) positions.push_back(static_cast<int>(i));
+    return positions;
+}
+
+static vector<int> sorted(vector<int> positions) {
+    sort(positions.begin(), positions.end());
+    return positions;
+}
+
+static const string SampleText =
+    "the quick brown fox jumps over the lazy dog; the quick brown cat naps under the lazy dog";
+
+// user-034: etiquetes al text indexat (init) i al pool (insert), curtes i llargues
+CHECK_CASE(radix_text_and_pool_labels) {
+    RadixTrie suffixes;
+    suffixes.init(SampleText);
+    for (const string& pattern : {string("the"), string("the quick brown "), string("lazy dog"), string("o"),
+                                  string("x"), string("zebra")}) {
+        CHECK(sorted(suffixes.starts_with(pattern)) == occurrences(SampleText, pattern));
+    }
+    CHECK(suffixes.search(SampleText.substr(40)) == vector<int>({40}));
+    CHECK(suffixes.get_words().size() == SampleText.length());
+
+    RadixTrie words;
+    string longer = "internationalization-of-long-labels";
+    words.insert(longer, 1);
+    words.insert(longer.substr(0, 20), 2);
+    words.insert("inter", 3);
+    words.insert(longer + "!", 4);
+    CHECK(words.search(longer) == vector<int>({1}));
+    CHECK(words.search(longer.substr(0, 20)) == vector<int>({2}));
+    CHECK(words.search(longer.substr(0, 21)).empty());
+    CHECK(sorted(words.starts_with("inter")) == vector<int>({1, 2, 3, 4}));
+    CHECK(words.profile().label_bytes > 0);
+}
+
+// Mateixa forma i mateix contingut: nodes, claus, profunditats i recorregut
+static bool same_tree(const RadixTrie& a, const RadixTrie& b) {
+    TrieProfile pa = a.profile();
+    TrieProfile pb = b.profile();
+    vector<pair<string, int>> wa = a.get_words();
+    vector<pair<string, int>> wb = b.get_words();
+    sort(wa.begin(), wa.end());
+    sort(wb.begin(), wb.end());
+    return pa.nodes == pb.nodes && pa.keys == pb.keys && pa.positions == pb.positions &&
+           pa.depth_histogram == pb.depth_histogram && pa.fanout_histogram == pb.fanout_histogram && wa == wb;
+}
+
+// user-038: init(x + y) i init(x) + append(y) construeixen el mateix arbre
+CHECK_CASE(radix_append_matches_init) {
+    for (const string& text : {string("ababc"), string("abababab"), string("mississippi$"), string("aaaaaaaab"),
+                               string("banana bandana"), SampleText}) {
+        RadixTrie whole;
+        whole.init(text);
+        for (size_t cut = 1; cut < text.length(); ++cut) {
+            RadixTrie appended;
+            appended.init(text.substr(0, cut));
+            appended.append(text.substr(cut));
+            CHECK(same_tree(whole, appended));
+        }
+
+        // També a trossos d'un byte
+        RadixTrie bytewise;
+        for (char c : text) bytewise.append(string(1, c));
+        CHECK(same_tree(whole, bytewise));
+    }
+
+    RadixTrie aba;
+    aba.init("aba");
+    aba.append("bc");
+    CHECK(aba.profile().nodes == 8);
+
+    // Una paraula inserida sense posicions sobreviu a append() encara que
+    // coincideixi amb un sufix tancat
+    RadixTrie mixed;
+    mixed.init("ab");
+    mixed.insert("ab");
+    mixed.insert("b", 7);
+    mixed.append("c");
+    CHECK(mixed.count_prefix("") == 5);  // ab, abc, b, bc, c
+    CHECK(mixed.count_prefix("ab") == 2 && mixed.select(0) == "ab");
+    CHECK(mixed.search("b") == vector<int>{7});
+    CHECK(mixed.search("abc") == vector<int>{0});
+    mixed.append("ab");
+    CHECK(mixed.count_prefix("ab") == 2 && mixed.rank("abcab") == 1);  // ab i abcab
+    CHECK(mixed.search("ab") == vector<int>{3});
+    CHECK(mixed.search("b") == vector<int>({7, 4}) || mixed.search("b") == vector<int>({4, 7}));
+}
+
+// Compara amb un arbre amb les mateixes claus i posicions construït de zero
+static bool same_as_rebuilt(const RadixTrie& trie) {
+    RadixTrie fresh;
+    for (const auto& word : trie.get_words()) fresh.insert(word.first, word.second);
+    return same_tree(trie, fresh);
+}
+
+// user-041: erase deixa l'arbre compacte, també sobre un índex fet amb append
+CHECK_CASE(radix_erase_keeps_tree_compact) {
+    RadixTrie appended;
+    appended.init("aba");
+    appended.append("bc");
+    CHECK(appended.erase("ababc") && appended.erase("abc"));
+    CHECK(!appended.erase("abc"));
+    CHECK(appended.profile().keys == 3);
+    CHECK(same_as_rebuilt(appended));
+
+    RadixTrie suffixes;
+    string text = "abracadabra abracadabra";
+    suffixes.init(text.substr(0, 9));
+    suffixes.append(text.substr(9));
+    for (size_t i = 0; i < text.length(); i += 3) {
+        CHECK(suffixes.erase(text.substr(i)));
+        CHECK(same_as_rebuilt(suffixes));
+    }
+
+    RadixTrie words(true);
+    vector<string> sample = check_words(400, 3, 17);
+    for (size_t i = 0; i < sample.size(); ++i) words.insert(sample[i], static_cast<int>(i));
+    set<string> erased;
+    for (size_t i = 0; i < sample.size(); i += 2) {
+        words.erase(sample[i]);
+        erased.insert(sample[i]);
+    }
+    for (const string& word : sample) CHECK(words.search_bool(word) == !erased.count(word));
+    CHECK(same_as_rebuilt(words));
+
+    // Amb l'índex hash: cap entrada no pot apuntar a un node alliberat per
+    // una fusió d'append() o d'erase()
+    RadixTrie indexed(true);
+    indexed.init("ab");
+    indexed.insert("ab");
+    indexed.append("c");
+    CHECK(indexed.search_bool("abc") && indexed.count_prefix("ab") == 2);
+    CHECK(indexed.search("ab").empty() && indexed.select(0) == "ab");
+    indexed.insert("abd", 4);
+    indexed.insert("abde", 5);
+    CHECK(indexed.erase("abd"));
+    CHECK(indexed.search("abde") == vector<int>{5} && indexed.search("abd").empty());
+    CHECK(indexed.erase("ab") && indexed.count_prefix("ab") == 2);  // abc i abde
+    CHECK(indexed.search("ab").empty() && indexed.search("abc") == vector<int>{0});
+    indexed.append("ab");
+    CHECK(indexed.search("abde") == vector<int>{5} && indexed.search("ab") == vector<int>{3});
+}
+
+// user-043: els comptadors del subarbre coincideixen amb enumerar-lo, també després d'append i erase
+CHECK_CASE(radix_subtree_counts) {
+    RadixTrie suffixes;
+    suffixes.init(SampleText.substr(0, 40));
+    suffixes.append(SampleText.substr(40));
+    suffixes.erase(SampleText.substr(10));
+    RadixTrie words;
+    vector<string> sample = check_words(500, 4, 23);
+    for (size_t i = 0; i < sample.size(); ++i) words.insert(sample[i], static_cast<int>(i));
+    for (size_t i = 0; i < sample.size(); i += 5) words.erase(sample[i]);
+
+    for (const RadixTrie* trie : {&suffixes, &words}) {
+        for (const string& prefix : {string(""), string("a"), string("th"), string("the lazy"), string("bad"),
+                                     string("dddd"), string("zz")}) {
+            set<string> keys;
+            for (const auto& word : trie->autocomplete(prefix)) keys.insert(word.first);
+            CHECK(trie->count_prefix(prefix) == keys.size());
+            CHECK(trie->count_positions(prefix) == trie->starts_with(prefix).size());
+        }
+    }
+    CHECK(suffixes.count_occurrences("the") == 4);
+}
+
+// user-044: rank, select i rangs sobre les claus ordenades
+CHECK_CASE(radix_ordered_access) {
+    RadixTrie trie;
+    vector<string> sample = check_words(400, 5, 29);
+    sample.push_back("\xc3\xa9t\xc3\xa9");  // bytes >= 0x80 van després de les lletres
+    set<string> keys;
+    for (size_t i = 0; i < sample.size(); ++i) {
+        trie.insert(sample[i], static_cast<int>(i));
+        keys.insert(sample[i]);
+    }
+    vector<string> ordered(keys.begin(), keys.end());
+
+    for (size_t k = 0; k < ordered.size(); ++k) {
+        CHECK(trie.select(k) == ordered[k]);
+        CHECK(trie.rank(ordered[k]) == k);
+    }
+    CHECK(trie.select(ordered.size()).empty());
+    CHECK(trie.rank("bb") == static_cast<size_t>(lower_bound(ordered.begin(), ordered.end(), "bb") - ordered.begin()));
+
+    vector<string> expected;
+    for (const string& key : ordered)
+        if (key >= "b" && key < "cab") expected.push_back(key);
+    vector<string> visited;
+    trie.for_each_in_range("b", "cab", [&](const string& key, const vector<int>&) {
+        visited.push_back(key);
+        return true;
+    });
+    CHECK(visited == expected);
+
+    size_t page = 0;
+    trie.for_each_in_range("", "", [&](const string&, const vector<int>&) { return ++page < 10; });
+    CHECK(page == 10);
+    CHECK(trie.range("d", "").size() == trie.count_positions("d") + trie.count_positions("e") + 1);
+}
+
+// user-046: subcadenes freqüents i repetides, construint amb init o amb append
+CHECK_CASE(radix_frequent_substrings) {
+    using Counts = vector<pair<string, size_t>>;
+    RadixTrie whole;
+    whole.init("ababc");
+    RadixTrie appended;
+    appended.init("aba");
+    appended.append("bc");
+    CHECK(whole.most_frequent_substrings(5, 1) == (Counts{{"ab", 2}, {"b", 2}}));
+    CHECK(appended.most_frequent_substrings(5, 1) == whole.most_frequent_substrings(5, 1));
+    CHECK(appended.most_frequent_substrings(5, 2) == (Counts{{"ab", 2}}));
+    CHECK(appended.longest_repeated_substring() == "ab");
+
+    RadixTrie sample;
+    sample.init(SampleText.substr(0, 60));
+    sample.append(SampleText.substr(60));
+    RadixTrie reference;
+    reference.init(SampleText);
+    CHECK(sample.most_frequent_substrings(10, 2) == reference.most_frequent_substrings(10, 2));
+    CHECK(sample.longest_repeated_substring() == reference.longest_repeated_substring());
+    for (const auto& entry : reference.most_frequent_substrings(10, 2))
+        CHECK(entry.second == occurrences(SampleText, entry.first).size());
+
+    CHECK(RadixTrie::longest_common_substring("xabcdy", "zzabcd") == "abcd");
+    CHECK(RadixTrie::longest_common_substring("abc", "xyz").empty());
+}
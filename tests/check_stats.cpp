@@ -0,0 +1,63 @@
+// Comprovacions de la instrumentació i del perfil de memòria
+
+#include "check.h"
+#include "stats.h"
+#include "profile.h"
+#include "naive.h"
+#include "radixDone.h"
+#include <cmath>
+#include <set>
+using namespace std;
+
+// user-032: els percentils de l'histograma tenen error relatiu acotat
+CHECK_CASE(stats_latency_histogram) {
+    LatencyHistogram histogram;
+    CHECK(histogram.count() == 0 && histogram.percentile(50) == 0);
+    for (uint64_t ns = 1; ns <= 10000; ++ns) histogram.record(ns);
+
+    CHECK(histogram.count() == 10000);
+    CHECK(histogram.min() == 1 && histogram.max() == 10000);
+    CHECK(fabs(histogram.mean() - 5000.5) < 1e-9);
+    for (double p : {50.0, 90.0, 99.0}) {
+        double exact = p * 100;
+        double reported = static_cast<double>(histogram.percentile(p));
+        CHECK(reported >= exact && reported <= exact * (1 + 1.0 / LatencyHistogram::SubBuckets));
+    }
+    CHECK(histogram.to_json().find("\"count\"") != string::npos);
+
+    histogram.reset();
+    CHECK(histogram.count() == 0 && histogram.max() == 0);
+}
+
+// user-033: el perfil compta els nodes i els bytes quadren amb les categories
+CHECK_CASE(profile_counts_and_bytes) {
+    vector<string> words = check_words(300, 4, 5);
+    NaiveTrie naive;
+    RadixTrie radix;
+    set<string> keys;
+    set<string> prefixes;
+    for (size_t i = 0; i < words.size(); ++i) {
+        naive.insert(words[i], static_cast<int>(i));
+        radix.insert(words[i], static_cast<int>(i));
+        keys.insert(words[i]);
+        for (size_t n = 1; n <= words[i].length(); ++n) prefixes.insert(words[i].substr(0, n));
+    }
+
+    TrieProfile report = naive.profile();
+    CHECK(report.keys == keys.size());
+    CHECK(report.nodes == prefixes.size() + 1);
+    CHECK(report.positions == words.size());
+    CHECK(report.total_bytes() == report.node_header_bytes + report.child_table_bytes + report.label_bytes +
+                                  report.position_bytes + report.allocator_overhead_bytes);
+
+    TrieProfile radix_report = radix.profile();
+    CHECK(radix_report.keys == keys.size());
+    CHECK(radix_report.nodes < report.nodes);
+    CHECK(radix_report.total_bytes() < report.total_bytes());
+
+    TrieProfile manual;
+    manual.add_allocation(24);
+    CHECK(manual.allocations == 1 && manual.allocator_overhead_bytes > 0);
+    CHECK(TrieProfile::string_heap_bytes("curt") == 0);
+    CHECK(TrieProfile::string_heap_bytes(string(100, 'x')) >= 100);
+}
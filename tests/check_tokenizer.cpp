@@ -0,0 +1,42 @@
+// Comprovacions del Tokenizer
+
+#include "check.h"
+#include "tokenizer.h"
+using namespace std;
+
+static vector<pair<string, size_t>> tokens_of(Tokenizer& tokenizer, const string& text, size_t base = 0) {
+    vector<pair<string, size_t>> tokens;
+    for (const Token& token : tokenizer.tokenize(text, base)) tokens.push_back({string(token.text), token.offset});
+    return tokens;
+}
+
+// user-040: termes en minúscules amb el seu desplaçament, igual amb cada ISA
+CHECK_CASE(tokenizer_terms_and_isas) {
+    Tokenizer scalar(Tokenizer::Isa::Scalar);
+    string text = "\xEF\xBB\xBF" "Don't PANIC: 42 caf\xC3\xA9s \xE2\x80\x94 r\xC3\xA9sum\xC3\xA9!";
+    vector<pair<string, size_t>> expected = {{"don", 3},  {"t", 7},  {"panic", 9},
+                                             {"42", 16}, {"caf\xC3\xA9s", 19}, {"r\xC3\xA9sum\xC3\xA9", 30}};
+    CHECK(tokens_of(scalar, text) == expected);
+    CHECK(tokens_of(scalar, text, 100).front().second == 103);
+
+    // U+206F (E2 81 AF) encara separa; els superíndexs U+2070-U+207F no
+    string superscripts = "x\xE2\x81\xB4 n\xE2\x81\xBF\xE2\x81\xAFy\xE2\x81\x84z";
+    vector<pair<string, size_t>> expected_superscripts = {
+        {"x\xE2\x81\xB4", 0}, {"n\xE2\x81\xBF", 5}, {"y", 12}, {"z", 16}};
+    CHECK(tokens_of(scalar, superscripts) == expected_superscripts);
+
+    // Text llarg perquè els camins SIMD processin blocs sencers i la cua
+    string longer;
+    for (int i = 0; i < 200; ++i) {
+        longer += text + (i % 3 ? " " : "\n") + to_string(i * 7919) + "ABC,def";
+        if (i % 7 == 0) longer += superscripts;
+    }
+    vector<pair<string, size_t>> reference = tokens_of(scalar, longer);
+    for (auto isa : {Tokenizer::Isa::SSE2, Tokenizer::Isa::AVX2}) {
+        if (!Tokenizer::supported(isa)) continue;
+        Tokenizer vectorized(isa);
+        CHECK(tokens_of(vectorized, longer) == reference);
+        CHECK(tokens_of(vectorized, text) == expected);
+        CHECK(tokens_of(vectorized, superscripts) == expected_superscripts);
+    }
+}